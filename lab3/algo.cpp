@@ -3,161 +3,311 @@
 #include <vector>
 #include <utility>
 #include <cassert>
-#include <queue>    //do generycznego Dijkstry, zlozonosc push: O(log n)
-                    //https://en.cppreference.com/w/cpp/container/priority_queue/push.html
-//implementacja generycznego Dijkstry z uzyciem kolejki priorytetowej (min-heap)
-void dijkstra(const Graph& g, int s, std::vector<Distance>& dist){
-    int n = static_cast<int>(g.size()-1);
-    dist.assign(n+1, INF);
-    dist[s] = 0;
-
-    using P = std::pair<Distance, int>; //para (odleglosc, wierzcholek)
-    std::priority_queue<P, std::vector<P>, std::greater<P>> pq;
-    pq.push({0, s});
+#include <algorithm> //std::push_heap / std::pop_heap, zlozonosc push: O(log n)
+                     //https://en.cppreference.com/w/cpp/algorithm/push_heap
+#include <functional>
+#include <type_traits>
+namespace {
+
+//wywoluje f(std::true_type) albo f(std::false_type) wedlug ws.trackParents, zeby
+//petle algorytmow byly kompilowane osobno z zapisem poprzednikow i bez niego
+template <class Workspace, class F>
+void withParents(const Workspace& ws, F f) {
+    if (ws.trackParents) f(std::true_type{});
+    else f(std::false_type{});
+}
+
+//implementacja generycznego Dijkstry z uzyciem kopca binarnego (min-heap)
+//i leniwego usuwania: poprawa odleglosci dodaje nowy wpis, stary jest pomijany
+template <bool Parents, class Dist>
+void dijkstraLazy(const Graph& g, int s, BasicQueryWorkspace<Dist>& ws){
+    ws.reset(g.n());
+    auto& dist = ws.dist;
+    ws.template setDistFrom<Parents>(s, 0, 0);
+
+    using P = typename BasicQueryWorkspace<Dist>::P;
+    auto& pq = ws.heap;
+    pq.clear();
+    pq.push_back({0, s});
+    LAB3_STATS_ONLY(++ws.stats.pushes;)
 
     while(!pq.empty()){
-        auto [d, u] = pq.top();
-        pq.pop();
-        if(d > dist[u]) continue; //stary wpis w kolejce
+        std::pop_heap(pq.begin(), pq.end(), std::greater<P>());
+        auto [d, u] = pq.back();
+        pq.pop_back();
+        LAB3_STATS_ONLY(++ws.stats.pops;)
+        if(d > dist[u]){ //stary wpis w kolejce
+            LAB3_STATS_ONLY(++ws.stats.stalePops;)
+            continue;
+        }
+        if(ws.settle(u, g[u].size())) break;
 
         for(const auto& [v, w] : g[u]){
             if(dist[u] + w < dist[v]){
-                dist[v] = dist[u] + w;
-                pq.push({dist[v], v});
+                ws.template setDistFrom<Parents>(v, dist[u] + w, u);
+                pq.push_back({dist[v], v});
+                std::push_heap(pq.begin(), pq.end(), std::greater<P>());
+                LAB3_STATS_ONLY(++ws.stats.relaxations; ++ws.stats.pushes;)
             }
         }
     }
 }
 
-void dial(const Graph& g, int s, std::vector<Distance>& dist, int C){
-    int n = static_cast<int>(g.size()-1);
-    dist.assign(n+1, INF);
-    dist[s] = 0;
+//Dijkstra na kolejce z decrease-key: kazdy wierzcholek jest w kolejce co najwyzej
+//raz, wiec rozmiar kolejki zalezy od n, a nie od m
+template <bool Parents, class Dist, class Queue>
+void dijkstraDecreaseKey(const Graph& g, int s, BasicQueryWorkspace<Dist>& ws, Queue& pq){
+    ws.reset(g.n());
+    auto& dist = ws.dist;
+    ws.template setDistFrom<Parents>(s, 0, 0);
 
-    //kubelki
-    int binCount = std::max(1, C+1);
-    std::vector<std::vector<int>> buckets(binCount);
+    pq.prepare(g.n());
+    pq.clear();
+    pq.update(s, 0);
+    LAB3_STATS_ONLY(++ws.stats.pushes;)
 
-    int currentBucket = 0;
-    buckets[0].push_back(s);
-
-    while(true){
-        //znajdz najblizszy niepusty kubelek
-        int steps = 0;
-        while(buckets[currentBucket].empty() && steps < binCount){
-            currentBucket = (currentBucket + 1) % binCount;
-            steps++;
-        }
-
-        //warunek zakonczenia
-        if(steps == binCount && buckets[currentBucket].empty()){
-            break; //wszystkie kubelki puste
-        }
-
-        int u = buckets[currentBucket].back();
-        buckets[currentBucket].pop_back();
-
-        Distance du = dist[u];
+    while(!pq.empty()){
+        auto [du, u] = pq.popMin();
+        LAB3_STATS_ONLY(++ws.stats.pops;)
+        if(ws.settle(u, g[u].size())) break;
 
-        //relaksacja krawedzi
         for(const auto& [v, w] : g[u]){
-            Distance dv = dist[v];
-            if(du + w < dv){
-                dist[v] = du + w;
-                int idx = static_cast<int>((du + w) % binCount);
-                buckets[idx].push_back(v);
+            if(du + w < dist[v]){
+                ws.template setDistFrom<Parents>(v, du + w, u);
+                pq.update(v, du + w);
+                LAB3_STATS_ONLY(++ws.stats.relaxations; ++ws.stats.pushes;)
             }
         }
     }
 }
 
-template <class Key>
-struct RadixHeap {
-    using U = unsigned long long; 
+} // namespace
 
-    //65 kubelek: 0..64 (wystarczajaco dla Distance = long long)
-    std::vector<std::pair<U,int>> buckets[65];
-    U last;
-    std::size_t sz; //ilosc elementow w kubelkach
-
-    RadixHeap() : last(0), sz(0) {}
+template <class Dist>
+void dijkstra(const Graph& g, int s, BasicQueryWorkspace<Dist>& ws, QueueKind queue){
+    withParents(ws, [&](auto parents) {
+        constexpr bool P = decltype(parents)::value;
+        switch (queue) {
+            case QueueKind::Binary: dijkstraLazy<P>(g, s, ws); break;
+            case QueueKind::Dary4: dijkstraDecreaseKey<P>(g, s, ws, ws.dary); break;
+            case QueueKind::Pairing: dijkstraDecreaseKey<P>(g, s, ws, ws.pairing); break;
+            case QueueKind::Fibonacci: dijkstraDecreaseKey<P>(g, s, ws, ws.fibonacci); break;
+        }
+    });
+}
 
-    bool empty() const { return sz == 0; }
-    std::size_t size() const { return sz; }
+//Dial na cyklicznej tablicy kubelkow: kubelek d % W trzyma wierzcholki o odleglosci d
+//z okna [cur, cur + W). Kazdy wierzcholek lezy w co najwyzej jednym kubelku (lista
+//dwukierunkowa, przy poprawie odleglosci jest przepinany), licznik `queued` mowi,
+//kiedy skonczyc, a bitmapa pozwala znalezc nastepny niepusty kubelek bez przegladania
+//pustych po kolei. Dla duzego C okno ma DIAL_MAX_BUCKETS kubelkow, a dalsze
+//wierzcholki czekaja w kopcu przepelnienia.
+namespace {
 
-    //dodanie elemetu o kluczu `key` i wartosci `v` do kubelkow
-    void push(Key key, int v) {
-        U x = static_cast<U>(key);
-        assert(x >= last);
+template <bool Parents, class Dist>
+void dialSearch(const Graph& g, int s, BasicQueryWorkspace<Dist>& ws, int C){
+    using Workspace = BasicQueryWorkspace<Dist>;
+    ws.reset(g.n());
+    auto& dist = ws.dist;
+    ws.template setDistFrom<Parents>(s, 0, 0);
 
-        int b = bucketIndex(x);
-        buckets[b].emplace_back(x, v);
-        ++sz;
-    }
-    //zwraca element o najmniejszym kluczu (z zerowego kubelka)
-    std::pair<Key,int> top() {
-        if (buckets[0].empty()) pull();
-        const auto &p = buckets[0].back();
-        return { static_cast<Key>(p.first), p.second };
+    //po pelnym przebiegu kubelki sa puste, wiec wystarczy je zachowac
+    const std::size_t binCount = static_cast<std::size_t>(std::min<long long>(std::max(1, C) + 1LL, DIAL_MAX_BUCKETS));
+    auto& head = ws.dialHead;
+    auto& next = ws.dialNext;
+    auto& prev = ws.dialPrev;
+    auto& bits = ws.dialBits;
+    if (head.size() != binCount) {
+        head.assign(binCount, -1);
+        bits.resize(binCount);
     }
-    //usuwa element o najmniejszym kluczu (z zerowego kubelka)
-    void pop() {
-        if (buckets[0].empty()) pull();
-        buckets[0].pop_back();
-        --sz;
+    if (prev.size() != dist.size()) {
+        next.assign(dist.size(), -1);
+        prev.assign(dist.size(), Workspace::DIAL_UNLISTED);
     }
 
-private:
-    //znajdz indeks kubelka dla klucza x
-    int bucketIndex(U x) const {
-        if (x == last) return 0;
-        U diff = x ^ last;
-        // msb position in [0..63]
-        int msb = 63 - __builtin_clzll(diff);
-        return msb + 1; // bucket 1..64
-    }
+    using P = typename Workspace::P;
+    auto& overflow = ws.dialOverflow;
+    overflow.clear();
 
-    //przeniesienie elementow z niepustego kubelka i > 0 do odpowiednich kubelkow
-    void pull() {
-        int i = 1;
-        while (i < 65 && buckets[i].empty()) ++i;
-        if(i >= 65){
-            throw std::runtime_error("RadixHeap pull() called on empty heap");
+    //okno liczone na Distance niezaleznie od Dist, zeby cur + W nie przepelnilo Distance32
+    const Distance W = static_cast<Distance>(binCount);
+    Distance cur = 0; //odleglosc aktualnego kubelka
+    std::size_t queued = 0; //liczba wierzcholkow w kubelkach
+
+    auto link = [&](int v, std::size_t idx) {
+        int h = head[idx];
+        next[v] = h;
+        prev[v] = -1;
+        if (h != -1) prev[h] = v;
+        head[idx] = v;
+        bits.set(idx);
+        ++queued;
+    };
+    auto unlink = [&](int v, std::size_t idx) {
+        if (prev[v] == -1) head[idx] = next[v];
+        else next[prev[v]] = next[v];
+        if (next[v] != -1) prev[next[v]] = prev[v];
+        prev[v] = Workspace::DIAL_UNLISTED;
+        if (head[idx] == -1) bits.reset(idx);
+        --queued;
+    };
+    auto enqueue = [&](int v, Distance d) {
+        LAB3_STATS_ONLY(++ws.stats.pushes;)
+        if (d < cur + W) {
+            link(v, static_cast<std::size_t>(d % W));
+        } else {
+            overflow.push_back({static_cast<Dist>(d), v});
+            std::push_heap(overflow.begin(), overflow.end(), std::greater<P>());
         }
+    };
+
+    enqueue(s, 0);
 
-        U new_last = buckets[i][0].first;
-        for (auto &p : buckets[i]) {
-            if (p.first < new_last) new_last = p.first;
+    while(queued > 0 || !overflow.empty()){
+        //okno puste: przeskocz do najmniejszej odleglosci z przepelnienia
+        if(queued == 0){
+            cur = overflow.front().first;
+        }
+        //wpisy z przepelnienia, ktore mieszcza sie juz w oknie
+        while(!overflow.empty() && overflow.front().first < cur + W){
+            std::pop_heap(overflow.begin(), overflow.end(), std::greater<P>());
+            auto [d, v] = overflow.back();
+            overflow.pop_back();
+            //stare wpisy (odleglosc poprawiona pozniej) pomijamy
+            if(d != dist[v] || prev[v] != Workspace::DIAL_UNLISTED){
+                LAB3_STATS_ONLY(++ws.stats.stalePops;)
+                continue;
+            }
+            link(v, static_cast<std::size_t>(d % W));
         }
-        last = new_last;
+        if(queued == 0) continue;
 
-        for (auto &p : buckets[i]) {
-            int b = bucketIndex(p.first);
-            buckets[b].push_back(p);
+        //najblizszy niepusty kubelek (cyklicznie od cur)
+        LAB3_STATS_ONLY(++ws.stats.bucketScans; Distance scanFrom = cur;)
+        std::size_t start = static_cast<std::size_t>(cur % W);
+        std::size_t idx = bits.findFrom(start);
+        if(idx != BucketBitmap::npos){
+            cur += static_cast<Distance>(idx - start);
+        } else {
+            idx = bits.findFrom(0);
+            cur += W - static_cast<Distance>(start) + static_cast<Distance>(idx);
+        }
+
+        LAB3_STATS_ONLY(ws.stats.bucketsSkipped += cur - scanFrom; ++ws.stats.pops;)
+
+        int u = head[idx];
+        unlink(u, idx);
+        Distance du = cur;
+        if(ws.settle(u, g[u].size())) break;
+
+        //relaksacja krawedzi
+        for(const auto& [v, w] : g[u]){
+            Dist dv = dist[v];
+            if(du + w < dv){
+                if(prev[v] != Workspace::DIAL_UNLISTED) unlink(v, static_cast<std::size_t>(dv % W));
+                ws.template setDistFrom<Parents>(v, static_cast<Dist>(du + w), u);
+                enqueue(v, du + w);
+                LAB3_STATS_ONLY(++ws.stats.relaxations;)
+            }
         }
-        buckets[i].clear();
     }
-};
 
-void radixheap(const Graph& g, int s, std::vector<Distance>& dist) {
-    int n = static_cast<int>(g.size() - 1);
-    dist.assign(n + 1, INF);
-    dist[s] = 0;
+    //przerwane po ustaleniu celow: odpinamy wierzcholki, ktore zostaly w kubelkach
+    if(queued > 0){
+        for(int v : ws.touched){
+            if(prev[v] == Workspace::DIAL_UNLISTED) continue;
+            std::size_t idx = static_cast<std::size_t>(dist[v] % W);
+            head[idx] = -1;
+            bits.reset(idx);
+            prev[v] = Workspace::DIAL_UNLISTED;
+        }
+    }
+}
+
+} // namespace
+
+template <class Dist>
+void dial(const Graph& g, int s, BasicQueryWorkspace<Dist>& ws, int C){
+    withParents(ws, [&](auto parents) { dialSearch<decltype(parents)::value>(g, s, ws, C); });
+}
+
+namespace {
 
-    RadixHeap<Distance> pq;
+template <bool Parents, class Dist, class Heap>
+void radixSearch(const Graph& g, int s, BasicQueryWorkspace<Dist>& ws, Heap& pq) {
+    ws.reset(g.n());
+    auto& dist = ws.dist;
+    ws.template setDistFrom<Parents>(s, 0, 0);
+
+    pq.clear();
     pq.push(0, s);
+    LAB3_STATS_ONLY(++ws.stats.pushes; pq.pulls = 0; pq.moved = 0;)
 
     while (!pq.empty()) {
         auto [d, u] = pq.top();
         pq.pop();
-        if (d > dist[u]) continue; 
+        LAB3_STATS_ONLY(++ws.stats.pops;)
+        if (d > dist[u]) {
+            LAB3_STATS_ONLY(++ws.stats.stalePops;)
+            continue;
+        }
+        if (ws.settle(u, g[u].size())) break;
 
         for (const auto& [v, w] : g[u]) {
             if (dist[u] + w < dist[v]) {
-                dist[v] = dist[u] + w;
+                ws.template setDistFrom<Parents>(v, dist[u] + w, u);
                 pq.push(dist[v], v);
+                LAB3_STATS_ONLY(++ws.stats.relaxations; ++ws.stats.pushes;)
+            }
+        }
+    }
+    LAB3_STATS_ONLY(ws.stats.radixPulls += pq.pulls; ws.stats.radixMoved += pq.moved;)
+}
+
+} // namespace
+
+template <class Dist>
+void radixheap(const Graph& g, int s, BasicQueryWorkspace<Dist>& ws, RadixVariant variant) {
+    withParents(ws, [&](auto parents) {
+        constexpr bool P = decltype(parents)::value;
+        switch (variant) {
+            case RadixVariant::Legacy: radixSearch<P>(g, s, ws, ws.radix); break;
+            case RadixVariant::Pooled: radixSearch<P>(g, s, ws, ws.radixPooled); break;
+            case RadixVariant::TwoLevel: radixSearch<P>(g, s, ws, ws.radixTwoLevel); break;
+        }
+    });
+}
+
+//BFS od s po lukach napietych (dist[u] + w == dist[v]); kolejnosc BFS zapewnia
+//drzewo bez cykli takze przy lukach o wadze 0
+template <class Dist>
+void parentsFromDistances(const Graph& g, int s, BasicQueryWorkspace<Dist>& ws) {
+    auto& dist = ws.dist;
+    auto& parent = ws.parent;
+    if (static_cast<int>(parent.size()) != g.n() + 1) parent.assign(g.n() + 1, 0);
+    for (int v : ws.touched) parent[v] = -1;
+    parent[s] = 0;
+
+    std::vector<int> queue;
+    queue.reserve(ws.touched.size());
+    queue.push_back(s);
+    for (std::size_t head = 0; head < queue.size(); ++head) {
+        int u = queue[head];
+        for (const auto& [v, w] : g[u]) {
+            if (parent[v] == -1 && dist[v] != BasicQueryWorkspace<Dist>::UNREACHED && dist[u] + w == dist[v]) {
+                parent[v] = u;
+                queue.push_back(v);
             }
         }
     }
 }
 
+template void dijkstra(const Graph&, int, QueryWorkspace&, QueueKind);
+template void dijkstra(const Graph&, int, QueryWorkspace32&, QueueKind);
+template void dial(const Graph&, int, QueryWorkspace&, int);
+template void dial(const Graph&, int, QueryWorkspace32&, int);
+template void radixheap(const Graph&, int, QueryWorkspace&, RadixVariant);
+template void radixheap(const Graph&, int, QueryWorkspace32&, RadixVariant);
+template void parentsFromDistances(const Graph&, int, QueryWorkspace&);
+template void parentsFromDistances(const Graph&, int, QueryWorkspace32&);
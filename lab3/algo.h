@@ -5,8 +5,27 @@
 #include <stdexcept>
 #include "common.h"
 #include "graph.h"
+#include "workspace.h"
+#include "cli.h"
 
-void dijkstra(const Graph& graph, int s, std::vector<Distance>& dist);
-void dial(const Graph& g, int s, std::vector<Distance>& dist, int C);
-void radixheap(const Graph& g, int s, std::vector<Distance>& dist);
+//gorne ograniczenie liczby kubelkow Diala (dla wiekszego C dziala kopiec przepelnienia)
+constexpr long long DIAL_MAX_BUCKETS = 1LL << 20;
 
+//wynik w ws.dist; workspace jest czyszczony leniwie, wiec kolejne zapytania
+//kosztuja proporcjonalnie do odwiedzonej czesci grafu. Po ws.setTargets(...)
+//wyszukiwanie konczy sie, gdy wszystkie cele sa ustalone; ws.settled i ws.relaxed
+//licza ustalone wierzcholki i przejrzane luki. Typ odleglosci wynika z workspace'u
+//(QueryWorkspace albo QueryWorkspace32); instancje dla obu sa w algo.cpp.
+//Przy ws.trackParents algorytmy zapisuja tez ws.parent (patrz ws.pathTo).
+template <class Dist>
+void dijkstra(const Graph& graph, int s, BasicQueryWorkspace<Dist>& ws, QueueKind queue = QueueKind::Binary);
+template <class Dist>
+void dial(const Graph& g, int s, BasicQueryWorkspace<Dist>& ws, int C);
+template <class Dist>
+void radixheap(const Graph& g, int s, BasicQueryWorkspace<Dist>& ws, RadixVariant variant = RadixVariant::TwoLevel);
+
+
+//odtwarza ws.parent z gotowych odleglosci ws.dist (dla algorytmow, ktore same
+//poprzednikow nie zapisuja, jak rownolegly delta-stepping)
+template <class Dist>
+void parentsFromDistances(const Graph& g, int s, BasicQueryWorkspace<Dist>& ws);
@@ -0,0 +1,421 @@
+//preprocessing i zapytania hierarchii skrotow
+#include "ch.h"
+#include "graphbin.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+
+namespace {
+
+//ile wierzcholkow moze zdjac jedno szukanie swiadka: przy ocenie priorytetu
+//wystarcza przyblizenie, przy faktycznej kontrakcji szukamy dokladniej
+constexpr int WITNESS_LIMIT_SIMULATE = 50;
+constexpr int WITNESS_LIMIT_CONTRACT = 500;
+
+//graf modyfikowany w trakcie kontrakcji (luki do usunietych wierzcholkow sa wycinane)
+struct DynamicGraph {
+    std::vector<std::vector<ChArc>> out;
+    std::vector<std::vector<ChArc>> in;
+
+    //dodaje luk u->v albo skraca istniejacy
+    void addArc(int u, int v, Distance w) {
+        for (auto& e : out[u]) {
+            if (e.to == v) {
+                if (w < e.w) {
+                    e.w = w;
+                    for (auto& r : in[v]) {
+                        if (r.to == u) { r.w = w; break; }
+                    }
+                }
+                return;
+            }
+        }
+        out[u].push_back({v, w});
+        in[v].push_back({u, w});
+    }
+
+    static void eraseTo(std::vector<ChArc>& list, int v) {
+        for (std::size_t i = 0; i < list.size(); ) {
+            if (list[i].to == v) {
+                list[i] = list.back();
+                list.pop_back();
+            } else {
+                ++i;
+            }
+        }
+    }
+};
+
+struct Shortcut {
+    int from;
+    int to;
+    Distance w;
+};
+
+//lokalne wyszukiwania swiadkow z czyszczeniem tylko odwiedzonych wierzcholkow
+class WitnessSearch {
+public:
+    explicit WitnessSearch(int n) : dist_(n+1, INF), targetMark_(n+1, 0), viaDist_(n+1, 0) {}
+
+    //Dijkstra od u z pominieciem `via` (w1 = waga luku u->via); konczy po
+    //rozstrzygnieciu wszystkich celow (wyjsciowych sasiadow `via`), po
+    //przekroczeniu najdluzszej sciezki przez `via` do nierozstrzygnietego celu
+    //albo po zdjeciu `settleLimit` wierzcholkow
+    void run(const DynamicGraph& dg, int u, int via, Distance w1, int settleLimit) {
+        for (int v : touched_) dist_[v] = INF;
+        touched_.clear();
+        heap_.clear(); //kopiec na wektorze, zeby nie alokowac przy kazdym szukaniu
+
+        ++stamp_;
+        int remaining = 0;
+        for (const auto& e : dg.out[via]) {
+            if (e.to == u) continue;
+            if (targetMark_[e.to] != stamp_) {
+                targetMark_[e.to] = stamp_;
+                viaDist_[e.to] = w1 + e.w;
+                ++remaining;
+            } else {
+                viaDist_[e.to] = std::min(viaDist_[e.to], w1 + e.w);
+            }
+        }
+        Distance limit = maxViaDist(dg, u, via);
+
+        dist_[u] = 0;
+        touched_.push_back(u);
+        heap_.push_back({0, u});
+        int settled = 0;
+
+        while (!heap_.empty() && remaining > 0) {
+            std::pop_heap(heap_.begin(), heap_.end(), std::greater<P>());
+            auto [d, x] = heap_.back();
+            heap_.pop_back();
+            if (d > dist_[x]) continue;
+            if (d > limit || ++settled > settleLimit) break;
+            if (targetMark_[x] == stamp_) {
+                targetMark_[x] = 0;
+                --remaining;
+                limit = maxViaDist(dg, u, via);
+            }
+
+            for (const auto& [y, w] : dg.out[x]) {
+                if (y == via) continue;
+                Distance nd = d + w;
+                if (nd < dist_[y]) {
+                    if (dist_[y] == INF) touched_.push_back(y);
+                    dist_[y] = nd;
+                    //swiadek juz znaleziony: dalsze poprawki nie zmienia wyniku
+                    if (targetMark_[y] == stamp_ && nd <= viaDist_[y]) {
+                        targetMark_[y] = 0;
+                        --remaining;
+                        limit = maxViaDist(dg, u, via);
+                    }
+                    heap_.push_back({nd, y});
+                    std::push_heap(heap_.begin(), heap_.end(), std::greater<P>());
+                }
+            }
+        }
+    }
+
+    Distance dist(int v) const { return dist_[v]; }
+
+private:
+    using P = std::pair<Distance, int>;
+
+    //dalej niz najdluzsza sciezka przez `via` do nierozstrzygnietego celu
+    //zaden swiadek juz sie nie znajdzie
+    Distance maxViaDist(const DynamicGraph& dg, int u, int via) const {
+        Distance m = -1;
+        for (const auto& e : dg.out[via]) {
+            if (e.to != u && targetMark_[e.to] == stamp_) m = std::max(m, viaDist_[e.to]);
+        }
+        return m;
+    }
+
+    std::vector<Distance> dist_;
+    std::vector<unsigned> targetMark_; //== stamp_ dla jeszcze nierozstrzygnietych celow
+    std::vector<Distance> viaDist_; //dlugosc sciezki u->via->cel
+    unsigned stamp_ = 0;
+    std::vector<int> touched_;
+    std::vector<P> heap_;
+};
+
+//skroty potrzebne po usunieciu v (sciezki u->v->x bez krotszego swiadka)
+void findShortcuts(const DynamicGraph& dg, int v, int settleLimit, WitnessSearch& ws, std::vector<Shortcut>& result) {
+    result.clear();
+    if (dg.in[v].empty() || dg.out[v].empty()) return;
+
+    for (const auto& [u, w1] : dg.in[v]) {
+        ws.run(dg, u, v, w1, settleLimit);
+        for (const auto& [x, w2] : dg.out[v]) {
+            if (x == u) continue;
+            Distance via = w1 + w2;
+            if (ws.dist(x) > via) result.push_back({u, x, via});
+        }
+    }
+}
+
+int priority(const DynamicGraph& dg, int v, const std::vector<int>& contractedNeighbours,
+             WitnessSearch& ws, std::vector<Shortcut>& buffer) {
+    findShortcuts(dg, v, WITNESS_LIMIT_SIMULATE, ws, buffer);
+    int removed = static_cast<int>(dg.in[v].size() + dg.out[v].size());
+    return static_cast<int>(buffer.size()) - removed + contractedNeighbours[v];
+}
+
+void buildUpwardGraph(int n, std::vector<std::vector<ChArc>>& lists, ChGraph& graph) {
+    graph.offsets.assign(n+2, 0);
+    for (int u = 1; u <= n; ++u) {
+        graph.offsets[u+1] = graph.offsets[u] + static_cast<int>(lists[u].size());
+    }
+    graph.arcs.clear();
+    graph.arcs.reserve(static_cast<std::size_t>(graph.offsets[n+1]));
+    for (int u = 1; u <= n; ++u) {
+        graph.arcs.insert(graph.arcs.end(), lists[u].begin(), lists[u].end());
+        std::vector<ChArc>().swap(lists[u]);
+    }
+}
+
+constexpr char CH_MAGIC[8] = {'A', 'O', 'D', 'C', 'H', 'I', 'E', 'R'};
+constexpr std::uint32_t CH_VERSION = 3;
+
+struct ChFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::int32_t n;
+    std::int32_t m;
+    std::int32_t shortcuts;
+    std::int64_t upArcs;
+    std::int64_t downArcs;
+    std::uint64_t sourceSize; //rozmiar i czas modyfikacji pliku .gr (jak w cache grafu)
+    std::int64_t sourceMtime;
+};
+
+//luki zapisywane jako dwie tablice (cele int32, wagi int64), bez dziur
+//wyrownania struktury ChArc w pliku
+void writeGraph(std::ofstream& out, const ChGraph& g) {
+    std::vector<std::int32_t> to(g.arcs.size());
+    std::vector<std::int64_t> w(g.arcs.size());
+    for (std::size_t i = 0; i < g.arcs.size(); ++i) {
+        to[i] = g.arcs[i].to;
+        w[i] = g.arcs[i].w;
+    }
+    out.write(reinterpret_cast<const char*>(g.offsets.data()), static_cast<std::streamsize>(g.offsets.size() * sizeof(int)));
+    out.write(reinterpret_cast<const char*>(to.data()), static_cast<std::streamsize>(to.size() * sizeof(std::int32_t)));
+    out.write(reinterpret_cast<const char*>(w.data()), static_cast<std::streamsize>(w.size() * sizeof(std::int64_t)));
+}
+
+bool readGraph(std::ifstream& in, int n, std::int64_t arcCount, ChGraph& g) {
+    if (arcCount < 0) return false;
+    const std::size_t arcs = static_cast<std::size_t>(arcCount);
+    std::vector<std::int32_t> to(arcs);
+    std::vector<std::int64_t> w(arcs);
+    g.offsets.resize(static_cast<std::size_t>(n) + 2);
+    in.read(reinterpret_cast<char*>(g.offsets.data()), static_cast<std::streamsize>(g.offsets.size() * sizeof(int)));
+    in.read(reinterpret_cast<char*>(to.data()), static_cast<std::streamsize>(arcs * sizeof(std::int32_t)));
+    in.read(reinterpret_cast<char*>(w.data()), static_cast<std::streamsize>(arcs * sizeof(std::int64_t)));
+    if (!in || g.offsets[n+1] != arcCount) return false;
+    g.arcs.resize(arcs);
+    for (std::size_t i = 0; i < arcs; ++i) g.arcs[i] = {to[i], w[i]};
+    return true;
+}
+
+} // namespace
+
+void buildContractionHierarchy(const Graph& g, ContractionHierarchy& ch) {
+    const int n = g.n();
+    DynamicGraph dg;
+    dg.out.assign(n+1, {});
+    dg.in.assign(n+1, {});
+    for (int u = 1; u <= n; ++u) {
+        for (const auto& [v, w] : g[u]) {
+            if (u != v) dg.addArc(u, v, w); //petle nie skracaja zadnej sciezki
+        }
+    }
+
+    WitnessSearch ws(n);
+    std::vector<Shortcut> shortcuts;
+    std::vector<int> contractedNeighbours(n+1, 0);
+    std::vector<char> contracted(n+1, 0);
+    std::vector<char> dirty(n+1, 0); //sasiedztwo zmienilo sie od ostatniej oceny
+
+    using P = std::pair<int, int>; //para (priorytet, wierzcholek)
+    std::priority_queue<P, std::vector<P>, std::greater<P>> order;
+    for (int v = 1; v <= n; ++v) {
+        order.push({priority(dg, v, contractedNeighbours, ws, shortcuts), v});
+    }
+
+    std::vector<std::vector<ChArc>> upLists(n+1);
+    std::vector<std::vector<ChArc>> downLists(n+1);
+    ch.n = n;
+    ch.shortcuts = 0;
+    ch.rank.assign(n+1, 0);
+    int nextRank = 0;
+
+    while (!order.empty()) {
+        auto [prio, v] = order.top();
+        order.pop();
+        if (contracted[v]) continue;
+
+        //leniwa aktualizacja: priorytet liczymy ponownie tylko, gdy od ostatniej
+        //oceny skontraktowano sasiada v; jesli sie pogorszyl, wroc do kolejki
+        if (dirty[v]) {
+            dirty[v] = 0;
+            int current = priority(dg, v, contractedNeighbours, ws, shortcuts);
+            if (!order.empty() && current > order.top().first) {
+                order.push({current, v});
+                continue;
+            }
+        }
+
+        findShortcuts(dg, v, WITNESS_LIMIT_CONTRACT, ws, shortcuts);
+
+        //pozostale luki v prowadza do wierzcholkow o wyzszej randze
+        upLists[v] = dg.out[v];
+        for (const auto& [u, w] : dg.in[v]) {
+            downLists[v].push_back({u, w});
+        }
+
+        for (const auto& sc : shortcuts) {
+            dg.addArc(sc.from, sc.to, sc.w);
+        }
+        ch.shortcuts += static_cast<int>(shortcuts.size());
+
+        for (const auto& e : dg.out[v]) {
+            DynamicGraph::eraseTo(dg.in[e.to], v);
+            contractedNeighbours[e.to]++;
+            dirty[e.to] = 1;
+        }
+        for (const auto& e : dg.in[v]) {
+            DynamicGraph::eraseTo(dg.out[e.to], v);
+            contractedNeighbours[e.to]++;
+            dirty[e.to] = 1;
+        }
+        std::vector<ChArc>().swap(dg.out[v]);
+        std::vector<ChArc>().swap(dg.in[v]);
+
+        contracted[v] = 1;
+        ch.rank[v] = nextRank++;
+    }
+
+    buildUpwardGraph(n, upLists, ch.up);
+    buildUpwardGraph(n, downLists, ch.down);
+}
+
+void saveContractionHierarchy(const std::string& path, const ContractionHierarchy& ch, const GraphMeta& meta,
+                              const std::string& graphPath) {
+    ChFileHeader h{};
+    std::memcpy(h.magic, CH_MAGIC, sizeof(CH_MAGIC));
+    h.version = CH_VERSION;
+    h.n = meta.n;
+    h.m = meta.m;
+    h.shortcuts = ch.shortcuts;
+    h.upArcs = ch.up.arcCount();
+    h.downArcs = ch.down.arcCount();
+    sourceStamp(graphPath, h.sourceSize, h.sourceMtime);
+
+    const std::string tmpPath = path + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Nie moge utworzyc pliku: " + tmpPath);
+    }
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(ch.rank.data()), static_cast<std::streamsize>(ch.rank.size() * sizeof(int)));
+    writeGraph(out, ch.up);
+    writeGraph(out, ch.down);
+    out.close();
+    if (!out || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("Nie moge zapisac pliku: " + path);
+    }
+}
+
+bool loadContractionHierarchy(const std::string& path, const std::string& graphPath, const GraphMeta& meta,
+                              ContractionHierarchy& ch) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    ChFileHeader h;
+    in.read(reinterpret_cast<char*>(&h), sizeof(h));
+    std::uint64_t size;
+    std::int64_t mtime;
+    sourceStamp(graphPath, size, mtime);
+    if (!in || std::memcmp(h.magic, CH_MAGIC, sizeof(CH_MAGIC)) != 0 || h.version != CH_VERSION
+        || h.n != meta.n || h.m != meta.m || h.sourceSize != size || h.sourceMtime != mtime) {
+        return false;
+    }
+
+    ch.n = h.n;
+    ch.shortcuts = h.shortcuts;
+    ch.rank.resize(static_cast<std::size_t>(h.n) + 1);
+    in.read(reinterpret_cast<char*>(ch.rank.data()), static_cast<std::streamsize>(ch.rank.size() * sizeof(int)));
+    return readGraph(in, h.n, h.upArcs, ch.up) && readGraph(in, h.n, h.downArcs, ch.down);
+}
+
+ChQuery::ChQuery(const ContractionHierarchy& ch)
+    : ch_(ch), distF_(ch.n+1, INF), distB_(ch.n+1, INF) {}
+
+void ChQuery::reset() {
+    for (int v : touched_) {
+        distF_[v] = INF;
+        distB_[v] = INF;
+    }
+    touched_.clear();
+    qF_ = Queue();
+    qB_ = Queue();
+}
+
+Distance ChQuery::query(int s, int t) {
+    if (s == t) return 0;
+    reset();
+
+    distF_[s] = 0;
+    distB_[t] = 0;
+    touched_.push_back(s);
+    touched_.push_back(t);
+    qF_.push({0, s});
+    qB_.push({0, t});
+
+    Distance best = INF;
+
+    //krok w jednym kierunku; `stall` to luki wchodzace z gory w tym kierunku
+    auto step = [&](Queue& q, const ChGraph& graph, const ChGraph& stall,
+                    std::vector<Distance>& dist, const std::vector<Distance>& other) {
+        auto [d, u] = q.top();
+        q.pop();
+        if (d > dist[u]) return; //stary wpis w kolejce
+
+        if (other[u] != INF && d + other[u] < best) {
+            best = d + other[u];
+        }
+
+        //stall-on-demand: u jest osiagalny krocej przez wierzcholek wyzej, nie rozwijaj go
+        for (const auto& [x, w] : stall[u]) {
+            if (dist[x] != INF && dist[x] + w < d) return;
+        }
+
+        for (const auto& [v, w] : graph[u]) {
+            Distance nd = d + w;
+            if (nd < dist[v]) {
+                if (dist[v] == INF && other[v] == INF) touched_.push_back(v);
+                dist[v] = nd;
+                q.push({nd, v});
+            }
+        }
+    };
+
+    //w CH kazdy kierunek moze skonczyc, gdy jego minimum przekroczy najlepszy wynik
+    while (!qF_.empty() || !qB_.empty()) {
+        bool forwardDone = qF_.empty() || qF_.top().first >= best;
+        bool backwardDone = qB_.empty() || qB_.top().first >= best;
+        if (forwardDone && backwardDone) break;
+
+        if (!forwardDone && (backwardDone || qF_.top().first <= qB_.top().first)) {
+            step(qF_, ch_.up, ch_.down, distF_, distB_);
+        } else {
+            step(qB_, ch_.down, ch_.up, distB_, distF_);
+        }
+    }
+    return best;
+}
@@ -0,0 +1,83 @@
+//hierarchie skrotow (contraction hierarchies) dla szybkich zapytan punkt-punkt
+#pragma once
+#include <vector>
+#include <string>
+#include <queue>
+#include <utility>
+#include <functional>
+#include <cstdint>
+#include "common.h"
+#include "graph.h"
+
+//luk hierarchii; waga skrotu jest suma wag calej sciezki, wiec nie musi sie
+//miescic w int jak waga krawedzi wejsciowej
+struct ChArc {
+    int to;
+    Distance w;
+};
+
+//graf CSR lukow hierarchii, uklad jak w Graph: luki u leza
+//w arcs[offsets[u] .. offsets[u+1]), wierzcholki od 1 do n
+struct ChGraph {
+    struct ArcRange {
+        const ChArc* first;
+        const ChArc* last;
+        const ChArc* begin() const { return first; }
+        const ChArc* end() const { return last; }
+    };
+
+    std::vector<int> offsets; //n+2 wpisow
+    std::vector<ChArc> arcs;
+
+    std::int64_t arcCount() const { return static_cast<std::int64_t>(arcs.size()); }
+    ArcRange operator[](int u) const {
+        return { arcs.data() + offsets[u], arcs.data() + offsets[u+1] };
+    }
+};
+
+//wynik preprocessingu: ranga kazdego wierzcholka oraz dwa grafy "w gore"
+//up:   luki u->v (oryginalne i skroty) z rank[v] > rank[u]
+//down: luki u->v z rank[u] > rank[v], zapisane odwrotnie jako v->u
+//(czyli tez w gore, dla wyszukiwania wstecz od celu)
+struct ContractionHierarchy {
+    int n = 0;
+    int shortcuts = 0; //liczba dodanych skrotow
+    std::vector<int> rank;
+    ChGraph up;
+    ChGraph down;
+};
+
+//kontrakcja wierzcholkow w kolejnosci rosnacej roznicy krawedzi
+//(skroty - usuniete luki + skontraktowani sasiedzi), z leniwa aktualizacja
+//priorytetow i ograniczonym wyszukiwaniem swiadkow
+void buildContractionHierarchy(const Graph& g, ContractionHierarchy& ch);
+
+//graphPath to plik .gr, z ktorego zbudowano hierarchie (jego rozmiar i czas
+//modyfikacji trafiaja do naglowka)
+void saveContractionHierarchy(const std::string& path, const ContractionHierarchy& ch, const GraphMeta& meta,
+                              const std::string& graphPath);
+//false, gdy pliku nie ma albo powstal dla innego grafu (inny plik .gr albo
+//inna liczba wierzcholkow lub lukow)
+bool loadContractionHierarchy(const std::string& path, const std::string& graphPath, const GraphMeta& meta,
+                              ContractionHierarchy& ch);
+
+//dwukierunkowe wyszukiwanie w gore hierarchii z "stall-on-demand"
+class ChQuery {
+public:
+    explicit ChQuery(const ContractionHierarchy& ch);
+
+    Distance query(int s, int t);
+
+private:
+    using P = std::pair<Distance, int>; //para (odleglosc, wierzcholek)
+    using Queue = std::priority_queue<P, std::vector<P>, std::greater<P>>;
+
+    void reset();
+
+    const ContractionHierarchy& ch_;
+    std::vector<Distance> distF_;
+    std::vector<Distance> distB_;
+    std::vector<int> touched_;
+    Queue qF_;
+    Queue qB_;
+};
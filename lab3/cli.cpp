@@ -11,6 +11,7 @@ ProgramOptions parseArgs(int argc, char* argv[]){
     bool haveD = false;
     bool haveSS = false;
     bool haveP2P = false;
+    bool haveCH = false;
 
     for(int i = 1; i <argc; ++i){
         std::string arg = argv[i];
@@ -44,6 +45,171 @@ ProgramOptions parseArgs(int argc, char* argv[]){
                 throw std::runtime_error("brak sciezki do pliku wynikowego po -op2p");
             }
             options.op2pPath = argv[++i];
+        } else if (arg == "-gbin") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak sciezki do pliku binarnego grafu po -gbin");
+            }
+            options.graphCachePath = argv[++i];
+        } else if (arg == "-gverify") {
+            options.verifyGraphCache = true;
+        } else if (arg == "-p2pengine") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak nazwy silnika po -p2pengine");
+            }
+            std::string engine = argv[++i];
+            if (engine == "sssp") {
+                options.p2pEngine = P2PEngine::SSSP;
+            } else if (engine == "bidir") {
+                options.p2pEngine = P2PEngine::Bidirectional;
+            } else if (engine == "alt") {
+                options.p2pEngine = P2PEngine::ALT;
+            } else {
+                throw std::runtime_error("nieznany silnik p2p: " + engine);
+            }
+        } else if (arg == "-ch") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak sciezki do pliku hierarchii po -ch");
+            }
+            options.chPath = argv[++i];
+            haveCH = true;
+        } else if (arg == "-threads") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak liczby watkow po -threads");
+            }
+            options.threads = std::stoi(argv[++i]);
+            if (options.threads < 0) {
+                throw std::runtime_error("liczba watkow nie moze byc ujemna");
+            }
+        } else if (arg == "-landmarks") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak liczby landmarkow po -landmarks");
+            }
+            options.landmarks = std::stoi(argv[++i]);
+            if (options.landmarks < 1) {
+                throw std::runtime_error("liczba landmarkow musi byc dodatnia");
+            }
+        } else if (arg == "-lmfile") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak sciezki do pliku landmarkow po -lmfile");
+            }
+            options.landmarksPath = argv[++i];
+        } else if (arg == "-queue") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak nazwy kolejki po -queue");
+            }
+            std::string queue = argv[++i];
+            if (queue == "binary") {
+                options.queue = QueueKind::Binary;
+            } else if (queue == "dary4") {
+                options.queue = QueueKind::Dary4;
+            } else if (queue == "pairing") {
+                options.queue = QueueKind::Pairing;
+            } else if (queue == "fibonacci") {
+                options.queue = QueueKind::Fibonacci;
+            } else {
+                throw std::runtime_error("nieznana kolejka: " + queue);
+            }
+        } else if (arg == "-oformat") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak nazwy formatu po -oformat");
+            }
+            std::string format = argv[++i];
+            if (format == "text") {
+                options.resultFormat = ResultFormat::Text;
+            } else if (format == "bin") {
+                options.resultFormat = ResultFormat::Binary;
+            } else {
+                throw std::runtime_error("nieznany format wynikow: " + format);
+            }
+        } else if (arg == "-stats") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak sciezki do pliku statystyk po -stats");
+            }
+            options.statsPath = argv[++i];
+        } else if (arg == "-opath") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak sciezki do pliku sciezek po -opath");
+            }
+            options.pathsPath = argv[++i];
+        } else if (arg == "-omatrix") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak sciezki do pliku macierzy po -omatrix");
+            }
+            options.matrixPath = argv[++i];
+        } else if (arg == "-delta") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak wartosci po -delta");
+            }
+            options.delta = std::stoll(argv[++i]);
+            if (options.delta < 1) {
+                throw std::runtime_error("delta musi byc dodatnie");
+            }
+        } else if (arg == "-dist") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak szerokosci odleglosci po -dist");
+            }
+            std::string width = argv[++i];
+            if (width == "auto") {
+                options.distanceWidth = DistanceWidth::Auto;
+            } else if (width == "32") {
+                options.distanceWidth = DistanceWidth::Bits32;
+            } else if (width == "64") {
+                options.distanceWidth = DistanceWidth::Bits64;
+            } else {
+                throw std::runtime_error("nieznana szerokosc odleglosci: " + width);
+            }
+        } else if (arg == "-reorder") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak nazwy przenumerowania po -reorder");
+            }
+            std::string kind = argv[++i];
+            if (kind == "none") {
+                options.reorder = ReorderKind::None;
+            } else if (kind == "bfs") {
+                options.reorder = ReorderKind::BFS;
+            } else if (kind == "rcm") {
+                options.reorder = ReorderKind::RCM;
+            } else if (kind == "dfs") {
+                options.reorder = ReorderKind::DFS;
+            } else {
+                throw std::runtime_error("nieznane przenumerowanie: " + kind);
+            }
+        } else if (arg == "-perm") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak sciezki do pliku permutacji po -perm");
+            }
+            options.permPath = argv[++i];
+        } else if (arg == "-algo") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak listy algorytmow po -algo");
+            }
+            std::string list = argv[++i];
+            options.algorithms.clear();
+            std::size_t start = 0;
+            while (start <= list.size()) {
+                std::size_t comma = list.find(',', start);
+                if (comma == std::string::npos) comma = list.size();
+                std::string name = list.substr(start, comma - start);
+                if (name.empty()) {
+                    throw std::runtime_error("pusta nazwa algorytmu w -algo: " + list);
+                }
+                options.algorithms.push_back(name);
+                start = comma + 1;
+            }
+        } else if (arg == "-radix") {
+            if (i + 1 >= argc) {
+                throw std::runtime_error("brak nazwy wariantu po -radix");
+            }
+            std::string variant = argv[++i];
+            if (variant == "legacy") {
+                options.radixVariant = RadixVariant::Legacy;
+            } else if (variant == "pooled") {
+                options.radixVariant = RadixVariant::Pooled;
+            } else if (variant == "2level") {
+                options.radixVariant = RadixVariant::TwoLevel;
+            } else {
+                throw std::runtime_error("nieznany wariant radix heap: " + variant);
+            }
         } else {
             throw std::runtime_error("nieznany argument: " + arg);
         }
@@ -65,6 +231,18 @@ ProgramOptions parseArgs(int argc, char* argv[]){
             throw std::runtime_error("brak sciezki do pliku wynikowego dla trybu p2p");
         }
     }
+    if(!options.pathsPath.empty() && (!haveP2P || haveCH)){
+        throw std::runtime_error("opcja -opath wymaga trybu -p2p bez -ch");
+    }
+    if(!options.permPath.empty() && options.reorder == ReorderKind::None){
+        throw std::runtime_error("opcja -perm wymaga -reorder");
+    }
+    if(haveCH){
+        if(!haveP2P){
+            throw std::runtime_error("tryb -ch wymaga pliku zapytan -p2p");
+        }
+        options.mode = Mode::CH;
+    }
     return options;
 }
 
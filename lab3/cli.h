@@ -1,11 +1,56 @@
 //parsowanie opcji wiersza poleceń
 #pragma once
 #include <string>
+#include <vector>
 #include <stdexcept>
 
 enum class Mode {
     SS,
-    P2P
+    P2P,
+    CH //zapytania p2p przez hierarchie skrotow
+};
+
+//sposob liczenia zapytan w trybie P2P
+enum class P2PEngine {
+    SSSP, //pelne drzewo z kazdego zrodla (domyslnie)
+    Bidirectional, //dwukierunkowy Dijkstra
+    ALT //A* z ograniczeniami z landmarkow
+};
+
+//kolejka priorytetowa Dijkstry
+enum class QueueKind {
+    Binary, //kopiec binarny z leniwym usuwaniem (domyslnie)
+    Dary4, //indeksowany kopiec 4-arny z decrease-key
+    Pairing, //kopiec parujacy
+    Fibonacci //kopiec Fibonacciego
+};
+
+//wariant radix heap w programie radixheap
+enum class RadixVariant {
+    Legacy, //65 kubelkow, pull() z dwoma przejsciami
+    Pooled, //kubelki z minimum i maska niepustych
+    TwoLevel //cyfry 8-bitowe (domyslnie)
+};
+
+//przenumerowanie wierzcholkow przed zapytaniami (reorder.h)
+enum class ReorderKind {
+    None, //numeracja z pliku .gr (domyslnie)
+    BFS, //kolejnosc przeszukiwania wszerz
+    RCM, //odwrocony Cuthill-McKee
+    DFS //kolejnosc przeszukiwania w glab (preorder)
+};
+
+//typ odleglosci w algorytmach SSSP
+enum class DistanceWidth {
+    Auto, //32 bity, gdy maxCost * n sie miesci, inaczej 64 (domyslnie)
+    Bits32, //jak Auto, ale z ostrzezeniem, gdy trzeba wrocic do 64 bitow
+    Bits64
+};
+
+//format pliku wynikowego p2p
+enum class ResultFormat {
+    Text, //linie d/u (domyslnie)
+    Binary //naglowek + rekordy (s, t, d) o stalej dlugosci
 };
 
 struct ProgramOptions {
@@ -15,6 +60,24 @@ struct ProgramOptions {
     std::string ossPath;
     std::string p2pPath;
     std::string op2pPath;
+    std::string graphCachePath; //-gbin: binarny cache grafu (pusty = brak)
+    bool verifyGraphCache = false; //-gverify: sprawdzaj sume kontrolna cache przy wczytaniu
+    int threads = 1; //-threads: watki dla trybu ss (0 = wszystkie rdzenie)
+    P2PEngine p2pEngine = P2PEngine::SSSP;
+    int landmarks = 8; //-landmarks: liczba landmarkow dla ALT
+    std::string chPath; //-ch: plik hierarchii skrotow (tryb CH)
+    std::string landmarksPath; //-lmfile: plik z tablicami landmarkow (pusty = licz za kazdym razem)
+    QueueKind queue = QueueKind::Binary; //-queue binary|dary4|pairing|fibonacci
+    ResultFormat resultFormat = ResultFormat::Text; //-oformat text|bin: format pliku -op2p
+    std::string statsPath; //-stats: plik JSON z czasami zapytan i licznikami
+    std::string pathsPath; //-opath: plik z ciagami wierzcholkow najkrotszych sciezek zapytan p2p
+    std::string matrixPath; //-omatrix: binarna macierz odleglosci dla linii s/t w pliku -p2p
+    long long delta = 0; //-delta: szerokosc kubelka delta-steppingu (0 = dobierana z grafu)
+    RadixVariant radixVariant = RadixVariant::TwoLevel; //-radix legacy|pooled|2level
+    DistanceWidth distanceWidth = DistanceWidth::Auto; //-dist auto|32|64
+    ReorderKind reorder = ReorderKind::None; //-reorder bfs|rcm|dfs
+    std::string permPath; //-perm: plik z permutacja dla -reorder (pusty = licz za kazdym razem)
+    std::vector<std::string> algorithms; //-algo a,b,...: algorytmy do porownania (puste = domyslny programu)
 };
 
 ProgramOptions parseArgs(int argc, char* argv[]);
@@ -1,5 +1,27 @@
 #pragma once
 #include <limits>
+#include <cstdint>
+#include <type_traits>
 
 using Distance = long long;
 constexpr Distance INF = std::numeric_limits<Distance>::max() / 4;
+
+//zwarte odleglosci (-dist 32): tablica dist i wpisy kolejek zajmuja polowe miejsca;
+//uzywane tylko gdy maxCost * n miesci sie ponizej INF32 (fitsDistance32 w graph.h)
+using Distance32 = std::uint32_t;
+constexpr Distance32 INF32 = std::numeric_limits<Distance32>::max();
+
+//"nieskonczonosc" dla typu odleglosci uzywanego przez algorytm
+template <class Dist>
+constexpr Dist infinityOf() {
+    static_assert(std::is_same<Dist, Distance>::value || std::is_same<Dist, Distance32>::value,
+                  "nieobslugiwany typ odleglosci");
+    if constexpr (std::is_same<Dist, Distance>::value) return INF;
+    else return INF32;
+}
+
+//odleglosc w typie Dist jako Distance (INF typu przechodzi w INF)
+template <class Dist>
+constexpr Distance toDistance(Dist d) {
+    return d == infinityOf<Dist>() ? INF : static_cast<Distance>(d);
+}
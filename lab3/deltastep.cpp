@@ -0,0 +1,210 @@
+//implementacja delta-steppingu
+#include "deltastep.h"
+#include "algo.h"
+#include <stdexcept>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+constexpr long long NO_BUCKET = std::numeric_limits<long long>::max();
+constexpr std::size_t CHUNK = 256; //wierzcholki frontu pobierane przez watek naraz
+
+} // namespace
+
+Distance defaultDelta(const GraphMeta& meta) {
+    double degree = meta.n > 0 ? static_cast<double>(meta.m) / meta.n : 1.0;
+    Distance delta = static_cast<Distance>(meta.maxCost / std::max(1.0, degree));
+    return std::max<Distance>({delta, meta.minCost, 1});
+}
+
+DeltaStepping::DeltaStepping(const Graph& g, Distance delta, int maxCost, int threads)
+    : g_(g), delta_(delta), threads_(std::max(1, threads)), barrier_(threads_) {
+    if (delta_ < 1) {
+        throw std::runtime_error("delta musi byc dodatnie");
+    }
+    //wpisy w kubelkach maja indeksy z [cur, cur + maxCost / delta + 1]
+    long long count = maxCost / delta_ + 2;
+    if (count > DELTA_MAX_BUCKETS) {
+        throw std::runtime_error("delta za male dla tego grafu (ponad 2^20 kubelkow), zwieksz -delta");
+    }
+    bucketCount_ = static_cast<std::size_t>(count);
+    locals_.resize(threads_);
+    for (auto& local : locals_) local.buckets.resize(bucketCount_);
+    offsets_.assign(threads_ + 1, 0);
+    for (int id = 1; id < threads_; ++id) {
+        pool_.emplace_back(&DeltaStepping::poolLoop, this, id);
+    }
+}
+
+DeltaStepping::~DeltaStepping() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : pool_) t.join();
+}
+
+//watek puli: czeka na kolejne zapytanie i liczy je jako watek `id`
+void DeltaStepping::poolLoop(int id) {
+    unsigned long long seen = 0;
+    while (true) {
+        std::function<void(int)> job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || round_ != seen; });
+            if (stop_) return;
+            seen = round_;
+            job = job_;
+        }
+        job(id);
+    }
+}
+
+template <class Dist>
+void DeltaStepping::run(int s, BasicQueryWorkspace<Dist>& ws) {
+    ws.reset(g_.n());
+    ws.setDist(s, 0);
+    Dist* dist = ws.dist.data();
+
+    for (auto& local : locals_) {
+        local.touched.clear();
+        local.scanned = 0;
+        local.relaxed = 0;
+    }
+    locals_[0].buckets[0].push_back(s);
+    locals_[0].queued = 1;
+
+    cur_ = 0;
+    done_ = false;
+    again_ = false;
+    nextBucket_.store(NO_BUCKET);
+    more_.store(false);
+    nextChunk_.store(0);
+
+    if (!pool_.empty()) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            job_ = [this, dist](int id) { worker<Dist>(id, dist); };
+            ++round_;
+        }
+        wake_.notify_all();
+    }
+    //worker konczy sie bariera wszystkich watkow, wiec po powrocie pozostale
+    //watki nie dotykaja juz stanu zapytania
+    worker<Dist>(0, dist);
+
+    //kazdy wierzcholek trafia do touched dokladnie raz (tylko jeden CAS zmienia UNREACHED)
+    for (const auto& local : locals_) {
+        ws.touched.insert(ws.touched.end(), local.touched.begin(), local.touched.end());
+        ws.settled += local.scanned;
+        ws.relaxed += local.relaxed;
+    }
+    //poprzednik zapisywany obok CAS moglby nie pasowac do zwycieskiej odleglosci,
+    //wiec drzewo jest odtwarzane po zakonczeniu z gotowych odleglosci
+    if (ws.trackParents) parentsFromDistances(g_, s, ws);
+}
+
+//atomowe min na dist[v]; zwyciezca CAS wklada v do swojego kubelka
+template <class Dist>
+void DeltaStepping::relax(Local& local, Dist* dist, int v, Dist nd) {
+    Dist old = __atomic_load_n(&dist[v], __ATOMIC_RELAXED);
+    while (nd < old) {
+        if (__atomic_compare_exchange_n(&dist[v], &old, nd, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+            if (old == infinityOf<Dist>()) local.touched.push_back(v);
+            local.buckets[static_cast<std::size_t>(nd / delta_) % bucketCount_].push_back(v);
+            ++local.queued;
+            return;
+        }
+    }
+}
+
+//najmniejszy indeks niepustego kubelka watku, nie mniejszy niz cur_
+long long DeltaStepping::firstBucket(const Local& local) const {
+    if (local.queued == 0) return NO_BUCKET;
+    for (std::size_t k = 0; k < bucketCount_; ++k) {
+        long long b = cur_ + static_cast<long long>(k);
+        if (!local.buckets[static_cast<std::size_t>(b) % bucketCount_].empty()) return b;
+    }
+    return NO_BUCKET;
+}
+
+template <class Dist>
+void DeltaStepping::worker(int id, Dist* dist) {
+    Local& local = locals_[id];
+    SpinBarrier& barrier = barrier_;
+
+    while (true) {
+        //wybor kubelka: minimum po wszystkich watkach
+        long long mine = firstBucket(local);
+        long long best = nextBucket_.load(std::memory_order_relaxed);
+        while (mine < best && !nextBucket_.compare_exchange_weak(best, mine, std::memory_order_relaxed)) {}
+        barrier.arriveAndWait([this] {
+            long long b = nextBucket_.load(std::memory_order_relaxed);
+            if (b == NO_BUCKET) done_ = true;
+            else cur_ = b;
+            nextBucket_.store(NO_BUCKET, std::memory_order_relaxed);
+        });
+        if (done_) {
+            //wszystkie watki odczytaly done_, zanim run() zwroci i nastepne zapytanie je wyzeruje
+            barrier.arriveAndWait();
+            break;
+        }
+
+        const long long cur = cur_;
+        std::vector<int>& slot = local.buckets[static_cast<std::size_t>(cur) % bucketCount_];
+        local.settled.clear();
+
+        //rundy lekkich krawedzi, dopoki kubelek nie jest pusty we wszystkich watkach
+        do {
+            local.frontier.clear();
+            local.frontier.swap(slot);
+            local.queued -= local.frontier.size();
+            barrier.arriveAndWait([this] {
+                for (int t = 0; t < threads_; ++t) offsets_[t + 1] = offsets_[t] + locals_[t].frontier.size();
+                nextChunk_.store(0, std::memory_order_relaxed);
+            });
+
+            const std::size_t total = offsets_[threads_];
+            for (std::size_t begin = nextChunk_.fetch_add(CHUNK); begin < total; begin = nextChunk_.fetch_add(CHUNK)) {
+                std::size_t end = std::min(begin + CHUNK, total);
+                int t = static_cast<int>(std::upper_bound(offsets_.begin(), offsets_.end(), begin) - offsets_.begin()) - 1;
+                for (std::size_t i = begin; i < end; ++i) {
+                    while (i >= offsets_[t + 1]) ++t;
+                    int u = locals_[t].frontier[i - offsets_[t]];
+                    Dist du = __atomic_load_n(&dist[u], __ATOMIC_RELAXED);
+                    if (du / delta_ != cur) continue; //stary wpis (u ma juz mniejsza odleglosc)
+                    local.settled.push_back(u);
+                    for (const auto& [v, w] : g_[u]) {
+                        if (w <= delta_) {
+                            relax(local, dist, v, static_cast<Dist>(du + w));
+                            ++local.relaxed;
+                        }
+                    }
+                }
+            }
+
+            if (!slot.empty()) more_.store(true, std::memory_order_relaxed);
+            barrier.arriveAndWait([this] {
+                again_ = more_.load(std::memory_order_relaxed);
+                more_.store(false, std::memory_order_relaxed);
+            });
+        } while (again_);
+
+        //ciezkie krawedzie: odleglosci wierzcholkow kubelka sa juz ostateczne
+        local.scanned += static_cast<long long>(local.settled.size());
+        for (int u : local.settled) {
+            Dist du = __atomic_load_n(&dist[u], __ATOMIC_RELAXED);
+            for (const auto& [v, w] : g_[u]) {
+                if (w > delta_) {
+                    relax(local, dist, v, static_cast<Dist>(du + w));
+                    ++local.relaxed;
+                }
+            }
+        }
+    }
+}
+
+template void DeltaStepping::run(int, QueryWorkspace&);
+template void DeltaStepping::run(int, QueryWorkspace32&);
@@ -0,0 +1,90 @@
+//rownolegly delta-stepping dla jednego zrodla
+#pragma once
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <cstddef>
+#include "common.h"
+#include "graph.h"
+#include "workspace.h"
+#include "parallel.h"
+
+//gorne ograniczenie liczby kubelkow cyklicznych (maxCost / delta + 2)
+constexpr long long DELTA_MAX_BUCKETS = 1LL << 20;
+
+//domyslna szerokosc kubelka: maxCost / sredni stopien (Meyer, Sanders), co najmniej
+//minCost i co najmniej 1
+Distance defaultDelta(const GraphMeta& meta);
+
+//Delta-stepping (Meyer, Sanders): kubelek i trzyma wierzcholki o odleglosci
+//w [i*delta, (i+1)*delta). Krawedzie lekkie (w <= delta) sa relaksowane w rundach
+//az kubelek sie oprozni, ciezkie raz po jego oproznieniu. Watki dziela sie frontem
+//kubelka, odleglosci sa poprawiane atomowym min (CAS), a kazdy watek wklada
+//wierzcholki do wlasnych kubelkow, wiec wstawianie nie wymaga synchronizacji.
+//Wynik jest identyczny z Dijkstra, bo najkrotsze odleglosci sa jednoznaczne.
+//Watki 1..threads-1 powstaja raz w konstruktorze i czekaja miedzy zapytaniami,
+//watek wywolujacy run() liczy jako watek 0.
+class DeltaStepping {
+public:
+    DeltaStepping(const Graph& g, Distance delta, int maxCost, int threads);
+    ~DeltaStepping();
+    DeltaStepping(const DeltaStepping&) = delete;
+    DeltaStepping& operator=(const DeltaStepping&) = delete;
+
+    //wynik w ws.dist (jak w algo.h); ws.touched zawiera osiagniete wierzcholki.
+    //ws.settled liczy przegladniecia wierzcholkow (wierzcholek poprawiony w tym
+    //samym kubelku jest przegladany ponownie), ws.relaxed relaksowane luki.
+    //Instancje dla QueryWorkspace i QueryWorkspace32 sa w deltastep.cpp.
+    template <class Dist>
+    void run(int s, BasicQueryWorkspace<Dist>& ws);
+
+    Distance delta() const { return delta_; }
+    int threads() const { return threads_; }
+
+private:
+    //stan jednego watku, wyrownany do linii cache
+    struct alignas(64) Local {
+        std::vector<std::vector<int>> buckets; //kubelki cykliczne (indeks % bucketCount_)
+        std::size_t queued = 0; //liczba wpisow w kubelkach
+        std::vector<int> frontier; //wpisy biezacego kubelka z tej rundy
+        std::vector<int> settled; //wierzcholki kubelka do relaksacji ciezkich krawedzi
+        std::vector<int> touched; //wierzcholki osiagniete przez ten watek
+        long long scanned = 0; //liczniki zapytania (ws.settled, ws.relaxed)
+        long long relaxed = 0;
+    };
+
+    void poolLoop(int id);
+    template <class Dist>
+    void worker(int id, Dist* dist);
+    template <class Dist>
+    void relax(Local& local, Dist* dist, int v, Dist nd);
+    long long firstBucket(const Local& local) const;
+
+    const Graph& g_;
+    Distance delta_;
+    int threads_;
+    std::size_t bucketCount_;
+    std::vector<Local> locals_;
+    SpinBarrier barrier_;
+
+    //pula watkow: job_ i round_ sa zmieniane pod mutex_, a kazdy watek puli
+    //wykonuje job_ raz dla kazdej nowej wartosci round_
+    std::vector<std::thread> pool_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::function<void(int)> job_;
+    unsigned long long round_ = 0;
+    bool stop_ = false;
+
+    //stan wspolny, zmieniany tylko w funkcjach konczacych bariere
+    long long cur_ = 0; //indeks biezacego kubelka
+    bool done_ = false;
+    bool again_ = false; //kolejna runda lekkich krawedzi w tym samym kubelku
+    std::vector<std::size_t> offsets_; //poczatki frontow watkow w numeracji wspolnej
+    std::atomic<long long> nextBucket_;
+    std::atomic<bool> more_;
+    std::atomic<std::size_t> nextChunk_;
+};
@@ -0,0 +1,6 @@
+//main dla rownoleglego delta-steppingu (alias: sssp -algo deltastepping)
+#include "driver.h"
+
+int main(int argc, char* argv[]){
+    return runDriver(argc, argv, "deltastepping", "deltastepping");
+}
@@ -0,0 +1,485 @@
+//wspolny main: graf wczytywany raz, zapytania liczone kolejno kazdym algorytmem
+#include "driver.h"
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <fstream>
+#include <unordered_map>
+#include <chrono>
+#include <mutex>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include "common.h"
+#include "graph.h"
+#include "graphbin.h"
+#include "io.h"
+#include "cli.h"
+#include "algo.h"
+#include "parallel.h"
+#include "resultwriter.h"
+#include "stats.h"
+#include "registry.h"
+#include "p2p.h"
+#include "ch.h"
+#include "m2m.h"
+#include "reorder.h"
+
+namespace {
+
+//wiersz tabeli porownawczej
+struct AlgoReport {
+    std::string name;
+    double avgTime = 0.0; //sredni czas zapytania [ms]
+    double p50 = 0.0;
+    double p99 = 0.0;
+    double wallTime = 0.0; //czas wszystkich zapytan [ms]
+    double throughput = 0.0; //zapytania na sekunde
+    long long settled = 0; //tylko p2p
+    long long relaxed = 0;
+};
+
+//przy kilku algorytmach kazdy dostaje wlasny plik: wyniki.ss.res -> wyniki.dial.ss.res
+std::string pathFor(const std::string& path, const std::string& algo, bool several) {
+    if (!several || path.empty()) return path;
+    std::size_t slash = path.find_last_of('/');
+    std::size_t dot = path.find('.', slash == std::string::npos ? 0 : slash + 1);
+    if (dot == std::string::npos) return path + "." + algo;
+    return path.substr(0, dot) + "." + algo + path.substr(dot);
+}
+
+void printReports(const std::vector<AlgoReport>& reports, bool p2p) {
+    std::cout << std::left << std::setw(15) << "algorytm" << std::right
+              << std::setw(13) << "sredni[ms]" << std::setw(13) << "p50[ms]" << std::setw(13) << "p99[ms]"
+              << std::setw(13) << "razem[ms]" << std::setw(13) << "zapytan/s";
+    if (p2p) std::cout << std::setw(14) << "ustalone" << std::setw(14) << "luki";
+    std::cout << "\n";
+    for (const auto& r : reports) {
+        std::cout << std::left << std::setw(15) << r.name << std::right << std::fixed << std::setprecision(3)
+                  << std::setw(13) << r.avgTime << std::setw(13) << r.p50 << std::setw(13) << r.p99
+                  << std::setw(13) << r.wallTime << std::setprecision(1) << std::setw(13) << r.throughput;
+        if (p2p) std::cout << std::setw(14) << r.settled << std::setw(14) << r.relaxed;
+        std::cout << "\n";
+    }
+    std::cout << std::defaultfloat;
+}
+
+template <class Workspace>
+AlgoReport runSS(ISssp& algo, const SingleSourceSet& ss, const GraphMeta& meta,
+                 const ProgramOptions& options, bool several) {
+    int threads = resolveThreads(options.threads);
+    bool parallel = algo.parallelQuery();
+
+    QueryStats counters;
+    std::mutex countersMutex;
+    SourceTimings timings = runSources<Workspace>(
+        ss.sources, parallel ? 1 : threads,
+        [&](Workspace& ws, int s) { algo.run(s, ws); },
+        [&](Workspace& ws) {
+            std::lock_guard<std::mutex> lock(countersMutex);
+            counters.add(ws.stats);
+        });
+
+    double avgTime = timings.avgTime;
+    SSThroughput throughput{parallel ? threads : timings.threads, timings.wallTime, timings.throughput};
+    LatencySummary latency = summarizeLatencies(timings.latencies);
+
+    std::ofstream out(pathFor(options.ossPath, algo.name(), several));
+    if (!out.is_open()) {
+        throw std::runtime_error("Nie mozna otworzyc pliku wyjsciowego");
+    }
+
+    saveSS(out, algo.name(), options.graphPath, options.ssPath, meta, avgTime, &throughput);
+    LAB3_STATS_ONLY(saveStatsComments(out, latency, counters);)
+    out.close();
+    if (!options.statsPath.empty()) {
+        saveStatsJson(pathFor(options.statsPath, algo.name(), several), algo.name(), "ss",
+                      timings.latencies, counters);
+    }
+
+    AlgoReport report;
+    report.name = algo.name();
+    report.avgTime = avgTime;
+    report.p50 = latency.p50;
+    report.p99 = latency.p99;
+    report.wallTime = timings.wallTime;
+    report.throughput = timings.throughput;
+    return report;
+}
+
+//sciezki zapytan p2p w jednej tablicy: sciezka zapytania i to
+//vertices[begin[i], begin[i] + length[i]) (length 0 = brak sciezki)
+struct QueryPaths {
+    std::vector<int> vertices;
+    std::vector<std::size_t> begin;
+    std::vector<std::size_t> length;
+};
+
+//zapytania p2p z jednym zrodlem (indeksy w p2p.queries)
+struct SourceGroup {
+    int s;
+    std::vector<std::size_t> indices;
+};
+
+//grupy w kolejnosci pierwszego wystapienia zrodla, zeby wyniki z poczatku pliku
+//byly gotowe jak najwczesniej
+std::vector<SourceGroup> groupBySource(const P2PQuerySet& p2p) {
+    std::vector<SourceGroup> groups;
+    std::unordered_map<int, std::size_t> groupOf;
+    groupOf.reserve(p2p.queries.size());
+    for (std::size_t i = 0; i < p2p.queries.size(); ++i) {
+        int s = p2p.queries[i].s;
+        auto [it, inserted] = groupOf.emplace(s, groups.size());
+        if (inserted) groups.push_back({s, {}});
+        groups[it->second].indices.push_back(i);
+    }
+    return groups;
+}
+
+//zapytania p2p pogrupowane po zrodle; z kazdego zrodla jedno wyszukiwanie
+//przerywane po ustaleniu wszystkich jego celow. Z paths != nullptr algorytm
+//sledzi poprzednikow, a sciezki (w numeracji grafu) trafiaja do paths.
+//groupDone (jesli jest) dostaje kazda grupe zaraz po wpisaniu jej wynikow.
+template <class Workspace>
+AlgoReport runP2P(ISssp& algo, int n, const P2PQuerySet& p2p, const std::vector<SourceGroup>& bySource,
+                  const ProgramOptions& options, bool several, std::vector<Distance>& results,
+                  QueryPaths* paths = nullptr,
+                  const std::function<void(const SourceGroup&)>& groupDone = nullptr) {
+    Workspace ws;
+    ws.trackParents = paths != nullptr;
+    if (paths) {
+        paths->vertices.clear();
+        paths->begin.assign(p2p.queries.size(), 0);
+        paths->length.assign(p2p.queries.size(), 0);
+    }
+    std::vector<int> path;
+    std::vector<int> targets;
+    AlgoReport report;
+    report.name = algo.name();
+    std::vector<double> latencies; //czas wyszukiwania z kazdego zrodla [ms]
+    results.assign(p2p.queries.size(), INF);
+
+    for (const auto& group : bySource) {
+        int s = group.s;
+        const auto& indices = group.indices;
+
+        targets.clear();
+        for (std::size_t idx : indices) targets.push_back(p2p.queries[idx].t);
+        ws.setTargets(targets, n);
+        auto start = std::chrono::high_resolution_clock::now();
+        algo.run(s, ws);
+        auto end = std::chrono::high_resolution_clock::now();
+        latencies.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        report.settled += ws.settled;
+        report.relaxed += ws.relaxed;
+
+        for (std::size_t idx : indices) {
+            int t = p2p.queries[idx].t;
+            if(t>=1 && t <= n){
+                results[idx] = toDistance(ws.dist[t]);
+            }
+            if (paths && ws.pathTo(t, path)) {
+                paths->begin[idx] = paths->vertices.size();
+                paths->length[idx] = path.size();
+                paths->vertices.insert(paths->vertices.end(), path.begin(), path.end());
+            }
+        }
+        if (groupDone) groupDone(group);
+    }
+
+    if (!options.statsPath.empty()) {
+        saveStatsJson(pathFor(options.statsPath, algo.name(), several), algo.name(), "p2p", latencies, ws.stats);
+    }
+
+    LatencySummary latency = summarizeLatencies(latencies);
+    report.avgTime = latency.mean;
+    report.p50 = latency.p50;
+    report.p99 = latency.p99;
+    for (double ms : latencies) report.wallTime += ms;
+    report.throughput = report.wallTime > 0 ? latencies.size() / (report.wallTime / 1000.0) : 0.0;
+    return report;
+}
+
+//macierz s/t (ids w numeracji z pliku .p2p); kazdy policzony wiersz od razu trafia
+//do watku zapisujacego out i do -omatrix, wiec zapis idzie rownolegle z obliczeniami
+void runTable(const P2PQuerySet& p2p, const ProgramOptions& options, ResultWriter& out,
+              const std::function<void(const TableRowSink&)>& compute) {
+    std::unique_ptr<TableBinaryWriter> matrix;
+    if (!options.matrixPath.empty()) {
+        matrix = std::make_unique<TableBinaryWriter>(options.matrixPath, p2p.sources, p2p.targets);
+    }
+    auto start = std::chrono::high_resolution_clock::now();
+    compute([&](std::size_t i, const Distance* row) {
+        writeTableRow(out, p2p.sources[i], p2p.targets, row);
+        if (matrix) matrix->writeRow(row);
+    });
+    auto end = std::chrono::high_resolution_clock::now();
+    std::cerr << "Macierz " << p2p.sources.size() << " x " << p2p.targets.size() << " policzona w "
+              << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+    if (matrix) matrix->close();
+}
+
+//zapytania w numeracji grafu po -reorder (wyniki sa zapisywane z numerami z pliku)
+P2PQuerySet toGraphIds(const P2PQuerySet& p2p, const VertexOrder& order) {
+    P2PQuerySet work = p2p;
+    if (order.empty()) return work;
+    for (auto& q : work.queries) {
+        q.s = order.toNew(q.s);
+        q.t = order.toNew(q.t);
+    }
+    for (int& v : work.sources) v = order.toNew(v);
+    for (int& v : work.targets) v = order.toNew(v);
+    return work;
+}
+
+void printUsage(const std::string& program) {
+    std::cerr << "Przyklad uzycia:\n"
+              << "  " << program << " -d plik_z_danymi.gr -ss zrodla.ss -oss wyniki.ss.res\n"
+              << "  " << program << " -d plik_z_danymi.gr -p2p pary.p2p -op2p wyniki.p2p.res\n"
+              << "  " << program << " -d plik_z_danymi.gr -ch hierarchia.ch -p2p pary.p2p -op2p wyniki.p2p.res\n"
+              << "  opcjonalnie: -algo a,b,... (dijkstra, dial, radixheap, deltastepping albo all)\n"
+              << "               -gbin graf.grb (binarny cache grafu), -gverify (sprawdz jego sume kontrolna)\n"
+              << "               -threads N (watki dla -ss, w deltastepping watki jednego zapytania; 0 = wszystkie rdzenie)\n"
+              << "               -stats plik.json (czasy zapytan; liczniki przy budowie make STATS=1)\n"
+              << "               -queue binary|dary4|pairing|fibonacci (kolejka Dijkstry)\n"
+              << "               -radix legacy|pooled|2level (wariant radix heap, domyslnie 2level)\n"
+              << "               -delta D (kubelek delta-steppingu, domyslnie maxCost / sredni stopien)\n"
+              << "               -oformat text|bin (format pliku -op2p)\n"
+              << "               -opath sciezki.txt (wierzcholki najkrotszej sciezki kazdej pary p2p)\n"
+              << "               -dist auto|32|64 (typ odleglosci, auto = 32 bity gdy maxCost * n sie miesci)\n"
+              << "               -reorder bfs|rcm|dfs -perm plik.perm (przenumerowanie wierzcholkow)\n"
+              << "               -p2pengine sssp|bidir|alt, -landmarks K -lmfile plik.lm,\n"
+              << "               -omatrix macierz.bin (tylko dla -algo dijkstra)\n";
+}
+
+}
+
+int runDriver(int argc, char* argv[], const std::string& program, const std::string& defaultAlgo) {
+    try{
+        ProgramOptions options = parseArgs(argc, argv);
+
+        std::vector<std::string> names = options.algorithms;
+        if (names.empty()) names.push_back(defaultAlgo);
+        if (names.size() == 1 && names[0] == "all") names = ssspNames();
+        for (const auto& name : names) {
+            //sprawdzane przed wczytaniem grafu, ktore moze trwac dlugo
+            if (std::find(ssspNames().begin(), ssspNames().end(), name) == ssspNames().end()) {
+                throw std::runtime_error("nieznany algorytm: " + name);
+            }
+        }
+        bool several = names.size() > 1;
+        //silniki p2p, hierarchia i macierz s/t sa zbudowane na Dijkstrze
+        bool dijkstraOnly = names.size() == 1 && names[0] == "dijkstra";
+
+        if (options.reorder != ReorderKind::None && (options.mode == Mode::CH || !options.landmarksPath.empty())) {
+            throw std::runtime_error("-reorder nie laczy sie z plikami -ch i -lmfile (zapisane w numeracji z pliku .gr)");
+        }
+
+        Graph g;
+        GraphMeta meta = loadGraphCached(options.graphPath, options.graphCachePath, g, options.verifyGraphCache);
+
+        //graf w nowej numeracji zastepuje wczytany; zapytania sa tlumaczone, a wyniki
+        //i pliki wynikowe zostaja w numeracji z plikow wejsciowych
+        VertexOrder order;
+        if (options.reorder != ReorderKind::None) {
+            auto start = std::chrono::high_resolution_clock::now();
+            if (options.permPath.empty() || !loadOrder(options.permPath, meta, options.reorder, order)) {
+                computeOrder(g, options.reorder, order);
+                if (!options.permPath.empty()) saveOrder(options.permPath, order, meta, options.reorder);
+            }
+            Graph permuted;
+            permuteGraph(g, order, permuted);
+            g = std::move(permuted);
+            auto end = std::chrono::high_resolution_clock::now();
+            std::cerr << "Przenumerowanie wierzcholkow w "
+                      << std::chrono::duration<double, std::milli>(end - start).count() << " ms\n";
+        }
+
+        //odleglosci 32-bitowe tylko wtedy, gdy zadna sciezka nie przekroczy INF32
+        bool narrow = options.distanceWidth != DistanceWidth::Bits64 && fitsDistance32(meta);
+        if (options.distanceWidth == DistanceWidth::Bits32 && !narrow) {
+            std::cerr << "Uwaga: maxCost * n nie miesci sie w 32 bitach, uzywam odleglosci 64-bitowych\n";
+        }
+
+        std::vector<std::unique_ptr<ISssp>> algos;
+        for (const auto& name : names) algos.push_back(makeSssp(name, g, meta, options));
+
+        if (options.mode == Mode::SS) {
+            SingleSourceSet ss = loadSS(options.ssPath);
+            if (ss.sources.empty()) {
+                throw std::runtime_error("brak zrodel w pliku zrodla -ss");
+            }
+            for (auto& s : ss.sources) {
+                if (s >= 1 && s <= g.n()) s = order.toNew(static_cast<int>(s));
+            }
+
+            std::vector<AlgoReport> reports;
+            for (auto& algo : algos) {
+                reports.push_back(narrow ? runSS<QueryWorkspace32>(*algo, ss, meta, options, several)
+                                         : runSS<QueryWorkspace>(*algo, ss, meta, options, several));
+            }
+            if (several) printReports(reports, false);
+        }
+        else if (options.mode == Mode::P2P) {
+            if (options.p2pEngine != P2PEngine::SSSP && !dijkstraOnly) {
+                throw std::runtime_error("silnik -p2pengine inny niz sssp wymaga -algo dijkstra");
+            }
+            if (options.p2pEngine != P2PEngine::SSSP && !options.pathsPath.empty()) {
+                throw std::runtime_error("opcja -opath wymaga silnika -p2pengine sssp");
+            }
+            P2PQuerySet p2p = loadP2P(options.p2pPath);
+            if (p2p.hasTable() && !dijkstraOnly) {
+                throw std::runtime_error("macierz odleglosci (linie s/t) wymaga -algo dijkstra");
+            }
+            if (p2p.queries.empty() && !p2p.hasTable()) {
+                throw std::runtime_error("brak par ani zbiorow s/t w pliku punkt-do-punktu -p2p");
+            }
+
+            P2PQuerySet work = toGraphIds(p2p, order);
+
+            ResultWriter out(options.op2pPath, options.resultFormat);
+            out.writeHeader(options.graphPath, options.p2pPath, meta);
+            std::vector<Distance> results(p2p.queries.size(), INF);
+            QueryPaths paths; //tylko z -opath, od pierwszego algorytmu
+            //wyniki sa zapisywane w kolejnosci zapytan, gdy tylko gotowy jest ich poczatek
+            std::vector<char> ready(p2p.queries.size(), 0);
+            std::size_t written = 0;
+            auto flushReady = [&]() {
+                while (written < ready.size() && ready[written]) {
+                    out.write(p2p.queries[written].s, p2p.queries[written].t, results[written]);
+                    ++written;
+                }
+            };
+
+            if (options.p2pEngine == P2PEngine::Bidirectional) {
+                Graph rg;
+                reverseGraph(g, rg);
+                BidirectionalDijkstra bidir(g, rg);
+
+                for (std::size_t i = 0; i < p2p.queries.size(); ++i) {
+                    int s = work.queries[i].s;
+                    int t = work.queries[i].t;
+                    if(s>=1 && s<=g.n() && t>=1 && t<=g.n()){
+                        results[i] = bidir.query(s, t);
+                    }
+                    out.write(p2p.queries[i].s, p2p.queries[i].t, results[i]);
+                }
+            } else if (options.p2pEngine == P2PEngine::ALT) {
+                Landmarks lm;
+                if (options.landmarksPath.empty() || !loadLandmarks(options.landmarksPath, options.graphPath, g.n(), options.landmarks, lm)) {
+                    Graph rg;
+                    reverseGraph(g, rg);
+                    selectLandmarks(g, rg, options.landmarks, lm);
+                    if (!options.landmarksPath.empty()) {
+                        saveLandmarks(options.landmarksPath, lm, options.graphPath);
+                    }
+                }
+                AltSearch alt(g, lm);
+
+                for (std::size_t i = 0; i < p2p.queries.size(); ++i) {
+                    int s = work.queries[i].s;
+                    int t = work.queries[i].t;
+                    if(s>=1 && s<=g.n() && t>=1 && t<=g.n()){
+                        results[i] = alt.query(s, t);
+                    }
+                    out.write(p2p.queries[i].s, p2p.queries[i].t, results[i]);
+                }
+            } else if (!p2p.queries.empty()) {
+                std::vector<SourceGroup> bySource = groupBySource(work);
+                auto groupDone = [&](const SourceGroup& group) {
+                    for (std::size_t idx : group.indices) ready[idx] = 1;
+                    flushReady();
+                };
+
+                //wynik pierwszego algorytmu trafia do pliku, kolejne sa z nim porownywane
+                std::vector<AlgoReport> reports;
+                std::vector<Distance> other;
+                for (std::size_t a = 0; a < algos.size(); ++a) {
+                    std::vector<Distance>& into = a == 0 ? results : other;
+                    QueryPaths* pathsInto = a == 0 && !options.pathsPath.empty() ? &paths : nullptr;
+                    std::function<void(const SourceGroup&)> done;
+                    if (a == 0) done = groupDone;
+                    reports.push_back(narrow ? runP2P<QueryWorkspace32>(*algos[a], g.n(), work, bySource, options, several, into, pathsInto, done)
+                                             : runP2P<QueryWorkspace>(*algos[a], g.n(), work, bySource, options, several, into, pathsInto, done));
+                    if (a > 0 && other != results) {
+                        throw std::runtime_error("algorytmy " + names[0] + " i " + names[a] + " daly rozne odleglosci");
+                    }
+                }
+
+                if (several) {
+                    printReports(reports, true);
+                } else {
+                    std::cerr << "Ustalone wierzcholki: " << reports[0].settled
+                              << ", przejrzane luki: " << reports[0].relaxed << "\n";
+                }
+            }
+
+            if (!options.pathsPath.empty()) {
+                ResultWriter pathsOut(options.pathsPath, ResultFormat::Text);
+                pathsOut.writeHeader(options.graphPath, options.p2pPath, meta);
+                std::vector<int> path;
+                for (std::size_t i = 0; i < paths.length.size(); ++i) {
+                    auto first = paths.vertices.begin() + static_cast<std::ptrdiff_t>(paths.begin[i]);
+                    path.assign(first, first + static_cast<std::ptrdiff_t>(paths.length[i]));
+                    for (int& v : path) v = order.toOld(v);
+                    pathsOut.writePath(p2p.queries[i].s, p2p.queries[i].t, path.data(), path.size());
+                }
+                pathsOut.close();
+            }
+
+            if (p2p.hasTable()) {
+                runTable(p2p, options, out, [&](const TableRowSink& sink) {
+                    computeTableDijkstra(g, work.sources, work.targets, sink);
+                });
+            }
+            out.close();
+        }
+        else if (options.mode == Mode::CH) {
+            if (!dijkstraOnly) {
+                throw std::runtime_error("tryb -ch wymaga -algo dijkstra");
+            }
+            P2PQuerySet p2p = loadP2P(options.p2pPath);
+            if (p2p.queries.empty() && !p2p.hasTable()) {
+                throw std::runtime_error("brak par ani zbiorow s/t w pliku punkt-do-punktu -p2p");
+            }
+
+            ContractionHierarchy ch;
+            if (!loadContractionHierarchy(options.chPath, options.graphPath, meta, ch)) {
+                auto start = std::chrono::high_resolution_clock::now();
+                buildContractionHierarchy(g, ch);
+                auto end = std::chrono::high_resolution_clock::now();
+                std::cerr << "Hierarchia zbudowana w "
+                          << std::chrono::duration<double, std::milli>(end - start).count()
+                          << " ms (" << ch.shortcuts << " skrotow)\n";
+                saveContractionHierarchy(options.chPath, ch, meta, options.graphPath);
+            }
+
+            ResultWriter out(options.op2pPath, options.resultFormat);
+            out.writeHeader(options.graphPath, options.p2pPath, meta);
+            ChQuery chq(ch);
+            for (const auto& q : p2p.queries) {
+                Distance d = INF;
+                if(q.s>=1 && q.s<=g.n() && q.t>=1 && q.t<=g.n()){
+                    d = chq.query(q.s, q.t);
+                }
+                out.write(q.s, q.t, d);
+            }
+
+            if (p2p.hasTable()) {
+                runTable(p2p, options, out, [&](const TableRowSink& sink) {
+                    computeTableCH(ch, p2p.sources, p2p.targets, sink);
+                });
+            }
+            out.close();
+        }
+        else {
+            throw std::runtime_error("Nieznany tryb dzialania programu");
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "Blad: " << e.what() << std::endl;
+        printUsage(program);
+        return 1;
+    }
+    return 0;
+}
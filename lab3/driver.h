@@ -0,0 +1,8 @@
+//wspolny main programow lab3 (sssp i aliasy dijkstra, dial, radixheap, deltastepping)
+#pragma once
+#include <string>
+
+//parsuje argumenty, wczytuje graf raz i liczy zapytania kazdym algorytmem z -algo
+//(bez -algo: defaultAlgo). Przy kilku algorytmach drukuje na stdout tabele czasow;
+//zwraca kod wyjscia programu.
+int runDriver(int argc, char* argv[], const std::string& program, const std::string& defaultAlgo);
@@ -1,51 +1,206 @@
 //kod do zaczytywania grafu z pliku
 #include "graph.h"
-#include <fstream>
+#include "mapped.h"
 #include <stdexcept>
 #include <iostream>
+#include <limits>
+#include <thread>
+#include <algorithm>
+#include <functional>
+#include <cstring>
 
-GraphMeta loadGraph(const std::string& path, Graph& graph) {
-    std::ifstream in(path);
-    if (!in) {
-        throw std::runtime_error("Nie moge otworzyc pliku: " + path);
+namespace {
+
+//sortowanie przez zliczanie lukow z kilku list (w kolejnosci list) do postaci CSR
+void buildFromLists(int n, const std::vector<ArcTriple>* lists, std::size_t count, Graph& graph) {
+    std::vector<int> offsets(n+2, 0);
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        for (const auto& a : lists[i]) {
+            offsets[a.from+1]++;
+        }
+        total += lists[i].size();
+    }
+    for (int u = 1; u <= n+1; ++u) {
+        offsets[u] += offsets[u-1];
     }
 
-    GraphMeta meta;
-    std::string token;
+    std::vector<Edge> arcs(total);
+    std::vector<int> pos(offsets.begin(), offsets.end()-1);
+    for (std::size_t i = 0; i < count; ++i) {
+        for (const auto& a : lists[i]) {
+            arcs[pos[a.from]++] = {a.to, a.w};
+        }
+    }
+    graph.assign(std::move(offsets), std::move(arcs));
+}
 
-    bool allocated = false;
+inline bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+inline const char* skipBlanks(const char* p, const char* end) {
+    while (p < end && isBlank(*p)) ++p;
+    return p;
+}
+
+inline const char* skipLine(const char* p, const char* end) {
+    const void* nl = std::memchr(p, '\n', static_cast<std::size_t>(end - p));
+    return nl ? static_cast<const char*>(nl) + 1 : end;
+}
+
+//caly token (do komunikatow o bledach)
+inline std::string tokenAt(const char* p, const char* end) {
+    const char* q = p;
+    while (q < end && !isBlank(*q) && *q != '\n') ++q;
+    return std::string(p, q);
+}
+
+//jednoliterowy token, po ktorym jest bialy znak lub koniec linii
+inline bool isTag(const char* p, const char* end, char tag) {
+    return *p == tag && (p+1 == end || isBlank(p[1]) || p[1] == '\n');
+}
+
+//liczba calkowita ze znakiem; petla po cyfrach bez rozgalezien poza warunkiem konca
+inline bool scanInt(const char*& p, const char* end, int& out) {
+    p = skipBlanks(p, end);
+    bool neg = (p < end && *p == '-');
+    p += neg;
+    const char* start = p;
+    long long x = 0;
+    while (p < end && static_cast<unsigned>(*p - '0') < 10u) {
+        x = x * 10 + (*p - '0');
+        ++p;
+    }
+    if (p == start || p - start > 10) return false;
+    x = neg ? -x : x;
+    if (x < std::numeric_limits<int>::min() || x > std::numeric_limits<int>::max()) return false;
+    out = static_cast<int>(x);
+    return true;
+}
+
+struct ChunkResult {
+    std::vector<ArcTriple> arcs;
     int minCost = std::numeric_limits<int>::max();
     int maxCost = 0;
+    std::string error; //pierwszy blad w kawalku (pusty gdy brak)
+};
 
-    while (in >> token){
-        if (token == "c"){ //komentarz
-            std::string commentLine;
-            std::getline(in, commentLine); //pomin reszte linii
-        } else if (token == "p"){ //definicja problemu > p sp n m 
-            std::string problemString;
-            in >> problemString >> meta.n >> meta.m;
-            if(!in){
-                throw std::runtime_error("Blad podczas czytania definicji problemu");
+//parsuje linie z przedzialu [p, end) ktory zaczyna sie na poczatku linii
+void parseChunk(const char* p, const char* end, int n, ChunkResult& res) {
+    while (p < end) {
+        p = skipBlanks(p, end);
+        if (p == end) break;
+        if (*p == '\n') { ++p; continue; }
+
+        if (isTag(p, end, 'a')) { //krawedz > a u v c
+            ++p;
+            int u, v, cost;
+            if (!scanInt(p, end, u) || !scanInt(p, end, v) || !scanInt(p, end, cost)) {
+                res.error = "Blad podczas czytania krawedzi";
+                return;
             }
-            graph.assign(meta.n+1, {});
-            allocated = true;
-        } else if (token == "a"){ //krawedz > a u v c
-            if(!allocated){
-                throw std::runtime_error("Krawedz zdefiniowana przed definicja problemu");
+            p = skipBlanks(p, end);
+            if (p < end && *p != '\n') { //za waga moze byc juz tylko koniec linii
+                res.error = "Nieznany token w pliku: " + tokenAt(p, end);
+                return;
             }
-            int u, v, cost;
-            in >> u >> v >> cost;
-            if(!in){
-                throw std::runtime_error("Blad podczas czytania krawedzi");
+            if (u<1 || u>n || v<1 || v>n) {
+                res.error = "Nieprawidlowy numer wierzcholka w krawedzi: " + std::to_string(u) + " " + std::to_string(v);
+                return;
             }
-            if(u<1 || u>meta.n || v<1 || v>meta.n){
-                throw std::runtime_error("Nieprawidlowy numer wierzcholka w krawedzi: " + std::to_string(u) + " " + std::to_string(v));
+            res.arcs.push_back({u, v, cost});
+            res.minCost = std::min(res.minCost, cost);
+            res.maxCost = std::max(res.maxCost, cost);
+            p = skipLine(p, end);
+        } else if (isTag(p, end, 'c')) { //komentarz
+            p = skipLine(p, end);
+        } else if (isTag(p, end, 'p')) {
+            res.error = "Powtorzona definicja problemu";
+            return;
+        } else {
+            res.error = "Nieznany token w pliku: " + tokenAt(p, end);
+            return;
+        }
+    }
+}
+
+} // namespace
+
+void Graph::assign(std::vector<int>&& offsets, std::vector<Edge>&& arcs) {
+    ownOffsets_ = std::move(offsets);
+    ownArcs_ = std::move(arcs);
+    owner_.reset();
+    n_ = static_cast<int>(ownOffsets_.size()) - 2;
+    offsets_ = ownOffsets_.data();
+    arcs_ = ownArcs_.data();
+}
+
+void Graph::assignView(int n, const int* offsets, const Edge* arcs, std::shared_ptr<const void> owner) {
+    ownOffsets_.clear();
+    ownOffsets_.shrink_to_fit();
+    ownArcs_.clear();
+    ownArcs_.shrink_to_fit();
+    owner_ = std::move(owner);
+    n_ = n;
+    offsets_ = offsets;
+    arcs_ = arcs;
+}
+
+void buildGraph(int n, const std::vector<ArcTriple>& list, Graph& graph) {
+    buildFromLists(n, &list, 1, graph);
+}
+
+void reverseGraph(const Graph& graph, Graph& reversed) {
+    const int n = graph.n();
+    std::vector<int> offsets(n+2, 0);
+    for (int u = 1; u <= n; ++u) {
+        for (const auto& e : graph[u]) {
+            offsets[e.to+1]++;
+        }
+    }
+    for (int u = 1; u <= n+1; ++u) {
+        offsets[u] += offsets[u-1];
+    }
+
+    std::vector<Edge> arcs(static_cast<std::size_t>(graph.arcCount()));
+    std::vector<int> pos(offsets.begin(), offsets.end()-1);
+    for (int u = 1; u <= n; ++u) {
+        for (const auto& e : graph[u]) {
+            arcs[pos[e.to]++] = {u, e.w};
+        }
+    }
+    reversed.assign(std::move(offsets), std::move(arcs));
+}
+
+GraphMeta loadGraph(const std::string& path, Graph& graph) {
+    MappedFile file(path, true);
+    const char* p = file.begin();
+    const char* end = file.end();
+
+    GraphMeta meta;
+
+    //naglowek: przed linia "p" moga byc tylko komentarze
+    bool allocated = false;
+    while (p < end && !allocated) {
+        p = skipBlanks(p, end);
+        if (p == end) break;
+        if (*p == '\n') { ++p; continue; }
+
+        if (isTag(p, end, 'c')) { //komentarz
+            p = skipLine(p, end);
+        } else if (isTag(p, end, 'p')) { //definicja problemu > p sp n m
+            ++p;
+            p = skipBlanks(p, end);
+            std::string problemString = tokenAt(p, end);
+            p += problemString.size();
+            if (problemString.empty() || !scanInt(p, end, meta.n) || !scanInt(p, end, meta.m)) {
+                throw std::runtime_error("Blad podczas czytania definicji problemu");
             }
-            graph[u].push_back({v, cost});
-            if(cost < minCost) minCost = cost;
-            if(cost > maxCost) maxCost = cost;
+            p = skipLine(p, end);
+            allocated = true;
+        } else if (isTag(p, end, 'a')) {
+            throw std::runtime_error("Krawedz zdefiniowana przed definicja problemu");
         } else {
-            throw std::runtime_error("Nieznany token w pliku: " + token);
+            throw std::runtime_error("Nieznany token w pliku: " + tokenAt(p, end));
         }
     }
 
@@ -53,6 +208,46 @@ GraphMeta loadGraph(const std::string& path, Graph& graph) {
         throw std::runtime_error("Brak definicji problemu w pliku");
     }
 
+    //podzial reszty pliku na kawalki zaczynajace sie od poczatku linii
+    constexpr std::size_t minChunkBytes = 1 << 20;
+    const std::size_t bodySize = static_cast<std::size_t>(end - p);
+    std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max<std::size_t>(1, std::min(threads, bodySize / minChunkBytes));
+
+    std::vector<const char*> bounds(threads + 1, end);
+    bounds[0] = p;
+    for (std::size_t i = 1; i < threads; ++i) {
+        const char* b = p + bodySize / threads * i;
+        bounds[i] = std::max(bounds[i-1], (b > p && b[-1] == '\n') ? b : skipLine(b, end));
+    }
+
+    std::vector<ChunkResult> chunks(threads);
+    for (auto& c : chunks) {
+        c.arcs.reserve(meta.m > 0 ? static_cast<std::size_t>(meta.m) / threads + 16 : 0);
+    }
+    std::vector<std::thread> workers;
+    for (std::size_t i = 1; i < threads; ++i) {
+        workers.emplace_back(parseChunk, bounds[i], bounds[i+1], meta.n, std::ref(chunks[i]));
+    }
+    parseChunk(bounds[0], bounds[1], meta.n, chunks[0]);
+    for (auto& w : workers) w.join();
+
+    //pierwszy blad w kolejnosci pliku
+    int minCost = std::numeric_limits<int>::max();
+    int maxCost = 0;
+    std::vector<std::vector<ArcTriple>> lists;
+    lists.reserve(threads);
+    for (auto& c : chunks) {
+        if (!c.error.empty()) {
+            throw std::runtime_error(c.error);
+        }
+        minCost = std::min(minCost, c.minCost);
+        maxCost = std::max(maxCost, c.maxCost);
+        lists.push_back(std::move(c.arcs));
+    }
+
+    buildFromLists(meta.n, lists.data(), lists.size(), graph);
+
     meta.minCost = (meta.m > 0 ? minCost : 0);
     meta.maxCost = maxCost;
     return meta;
@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <string>
+#include <memory>
 #include "common.h"
 
 struct Edge {
@@ -10,7 +11,48 @@ struct Edge {
     int w; //waga krawędzi
 };
 
-using Graph = std::vector<std::vector<Edge>>;
+//graf w postaci CSR (compressed sparse row): luki wierzcholka u leza
+//w arcs[offsets[u] .. offsets[u+1]), wierzcholki numerowane od 1 do n.
+//Tablice naleza do grafu albo sa widokiem na pamiec zewnetrzna (zmapowany
+//plik binarny), ktora trzyma przy zyciu `owner`.
+class Graph {
+public:
+    //widok na luki jednego wierzcholka, zeby dalo sie pisac for(auto& [v, w] : g[u])
+    struct ArcRange {
+        const Edge* first;
+        const Edge* last;
+        const Edge* begin() const { return first; }
+        const Edge* end() const { return last; }
+        int size() const { return static_cast<int>(last - first); }
+    };
+
+    Graph() = default;
+    Graph(Graph&&) = default; //przeniesienie wektora nie zmienia adresu danych
+    Graph& operator=(Graph&&) = default;
+    Graph(const Graph&) = delete;
+    Graph& operator=(const Graph&) = delete;
+
+    //przejmuje tablice offsets (n+2 wpisow, offsets[0] == offsets[1] == 0) i arcs
+    void assign(std::vector<int>&& offsets, std::vector<Edge>&& arcs);
+    //ustawia widok na cudze tablice bez kopiowania
+    void assignView(int n, const int* offsets, const Edge* arcs, std::shared_ptr<const void> owner);
+
+    int n() const { return n_; }
+    int arcCount() const { return offsets_ ? offsets_[n_+1] : 0; }
+    const int* offsets() const { return offsets_; }
+    const Edge* arcs() const { return arcs_; }
+    ArcRange operator[](int u) const {
+        return { arcs_ + offsets_[u], arcs_ + offsets_[u+1] };
+    }
+
+private:
+    std::vector<int> ownOffsets_;
+    std::vector<Edge> ownArcs_;
+    std::shared_ptr<const void> owner_;
+    const int* offsets_ = nullptr;
+    const Edge* arcs_ = nullptr;
+    int n_ = 0;
+};
 
 struct GraphMeta {
     int n; //liczba wierzchołków
@@ -19,4 +61,25 @@ struct GraphMeta {
     int maxCost; //maksymalny koszt krawędzi
 };
 
+//true, gdy kazda odleglosc (co najwyzej maxCost * (n-1)) i kazda relaksacja z niej
+//miesci sie ponizej INF32, wiec algorytmy moga liczyc na Distance32
+inline bool fitsDistance32(const GraphMeta& meta) {
+    return meta.minCost >= 0
+        && static_cast<unsigned long long>(meta.maxCost) * static_cast<unsigned long long>(meta.n) < INF32;
+}
+
+//luk w postaci listy krawedzi, z ktorej budowany jest graf CSR
+struct ArcTriple {
+    int from;
+    int to;
+    int w;
+};
+
+//buduje graf CSR o n wierzcholkach (sortowanie przez zliczanie, kolejnosc lukow
+//kazdego wierzcholka zgodna z kolejnoscia na liscie)
+void buildGraph(int n, const std::vector<ArcTriple>& list, Graph& graph);
+
+//graf odwrocony: luk u->v o wadze w staje sie lukiem v->u
+void reverseGraph(const Graph& graph, Graph& reversed);
+
 GraphMeta loadGraph(const std::string& path, Graph& graph);
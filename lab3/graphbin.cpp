@@ -0,0 +1,174 @@
+//zapis i odczyt binarnego formatu grafu
+#include "graphbin.h"
+#include "mapped.h"
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <sys/stat.h>
+
+namespace {
+
+constexpr char MAGIC[8] = {'A', 'O', 'D', 'G', 'R', 'A', 'P', 'H'};
+constexpr std::uint64_t ALIGN = 64;
+
+std::uint64_t alignUp(std::uint64_t x) { return (x + ALIGN - 1) / ALIGN * ALIGN; }
+
+//64-bitowy hash slow z czterema niezaleznymi torami (zeby nie czekac na mnozenie)
+std::uint64_t checksumBytes(const void* data, std::size_t bytes, std::uint64_t seed) {
+    constexpr std::uint64_t PRIME = 0x9E3779B185EBCA87ULL;
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    std::uint64_t lane[4] = {seed, seed ^ 1, seed ^ 2, seed ^ 3};
+    std::size_t i = 0;
+    for (; i + 32 <= bytes; i += 32) {
+        for (int k = 0; k < 4; ++k) {
+            std::uint64_t w;
+            std::memcpy(&w, p + i + 8 * k, 8);
+            lane[k] = (lane[k] ^ w) * PRIME;
+        }
+    }
+    std::uint64_t h = lane[0] ^ (lane[1] << 1) ^ (lane[2] << 2) ^ (lane[3] << 3);
+    for (; i < bytes; ++i) {
+        h = (h ^ p[i]) * PRIME;
+    }
+    return h ^ bytes;
+}
+
+std::uint64_t graphChecksum(const int* offsets, std::size_t offsetCount, const Edge* arcs, std::size_t arcCount) {
+    std::uint64_t h = checksumBytes(offsets, offsetCount * sizeof(int), 0);
+    return checksumBytes(arcs, arcCount * sizeof(Edge), h);
+}
+
+void writePadding(std::ofstream& out, std::uint64_t from, std::uint64_t to) {
+    static const char zeros[ALIGN] = {};
+    out.write(zeros, static_cast<std::streamsize>(to - from));
+}
+
+} // namespace
+
+void sourceStamp(const std::string& path, std::uint64_t& size, std::int64_t& mtime) {
+    struct stat st;
+    if (path.empty() || ::stat(path.c_str(), &st) != 0) {
+        size = 0;
+        mtime = 0;
+        return;
+    }
+    size = static_cast<std::uint64_t>(st.st_size);
+    mtime = static_cast<std::int64_t>(st.st_mtime);
+}
+
+void saveGraphBinary(const std::string& path, const Graph& graph, const GraphMeta& meta,
+                     const std::string& sourcePath) {
+    static_assert(sizeof(Edge) == 8, "Edge musi miec uklad {int32, int32}");
+
+    const std::size_t offsetCount = static_cast<std::size_t>(graph.n()) + 2;
+    const std::size_t arcCount = static_cast<std::size_t>(graph.arcCount());
+
+    GraphFileHeader h{};
+    std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+    h.version = GRAPH_FILE_VERSION;
+    h.headerSize = sizeof(GraphFileHeader);
+    h.n = meta.n;
+    h.m = meta.m;
+    h.minCost = meta.minCost;
+    h.maxCost = meta.maxCost;
+    h.arcCount = arcCount;
+    h.offsetsPos = alignUp(sizeof(GraphFileHeader));
+    h.arcsPos = alignUp(h.offsetsPos + offsetCount * sizeof(int));
+    sourceStamp(sourcePath, h.sourceSize, h.sourceMtime);
+    h.checksum = graphChecksum(graph.offsets(), offsetCount, graph.arcs(), arcCount);
+
+    const std::string tmpPath = path + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Nie moge utworzyc pliku: " + tmpPath);
+    }
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    writePadding(out, sizeof(h), h.offsetsPos);
+    out.write(reinterpret_cast<const char*>(graph.offsets()), static_cast<std::streamsize>(offsetCount * sizeof(int)));
+    writePadding(out, h.offsetsPos + offsetCount * sizeof(int), h.arcsPos);
+    out.write(reinterpret_cast<const char*>(graph.arcs()), static_cast<std::streamsize>(arcCount * sizeof(Edge)));
+    out.close();
+    if (!out) {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("Blad zapisu pliku: " + tmpPath);
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("Nie moge zapisac pliku: " + path);
+    }
+}
+
+GraphMeta loadGraphBinary(const std::string& path, Graph& graph, bool verify) {
+    auto file = std::make_shared<MappedFile>(path);
+
+    GraphFileHeader h;
+    if (file->size() < sizeof(h)) {
+        throw std::runtime_error("Plik binarny grafu jest za krotki: " + path);
+    }
+    std::memcpy(&h, file->begin(), sizeof(h));
+    if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw std::runtime_error("To nie jest plik binarny grafu: " + path);
+    }
+    if (h.version != GRAPH_FILE_VERSION || h.headerSize != sizeof(GraphFileHeader)) {
+        throw std::runtime_error("Nieobslugiwana wersja pliku binarnego grafu: " + path);
+    }
+
+    const std::uint64_t offsetCount = static_cast<std::uint64_t>(h.n) + 2;
+    if (h.n < 0 || h.offsetsPos % ALIGN != 0 || h.arcsPos % ALIGN != 0
+        || h.offsetsPos + offsetCount * sizeof(int) > h.arcsPos
+        || h.arcsPos + h.arcCount * sizeof(Edge) > file->size()) {
+        throw std::runtime_error("Uszkodzony plik binarny grafu: " + path);
+    }
+
+    const int* offsets = reinterpret_cast<const int*>(file->begin() + h.offsetsPos);
+    const Edge* arcs = reinterpret_cast<const Edge*>(file->begin() + h.arcsPos);
+    if (static_cast<std::uint64_t>(offsets[h.n+1]) != h.arcCount) {
+        throw std::runtime_error("Uszkodzony plik binarny grafu: " + path);
+    }
+    if (verify && graphChecksum(offsets, offsetCount, arcs, h.arcCount) != h.checksum) {
+        throw std::runtime_error("Niezgodna suma kontrolna pliku binarnego grafu: " + path);
+    }
+
+    graph.assignView(h.n, offsets, arcs, file);
+
+    GraphMeta meta;
+    meta.n = h.n;
+    meta.m = h.m;
+    meta.minCost = h.minCost;
+    meta.maxCost = h.maxCost;
+    return meta;
+}
+
+GraphMeta loadGraphCached(const std::string& grPath, const std::string& cachePath, Graph& graph,
+                          bool verify) {
+    if (cachePath.empty()) {
+        return loadGraph(grPath, graph);
+    }
+
+    GraphFileHeader h{};
+    {
+        std::ifstream in(cachePath, std::ios::binary);
+        in.read(reinterpret_cast<char*>(&h), sizeof(h));
+        if (!in) h.version = 0; //brak lub niepelny cache
+    }
+    std::uint64_t size;
+    std::int64_t mtime;
+    sourceStamp(grPath, size, mtime);
+    bool fresh = std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) == 0
+        && h.version == GRAPH_FILE_VERSION
+        && h.sourceSize == size && h.sourceMtime == mtime;
+
+    if (fresh) {
+        try {
+            return loadGraphBinary(cachePath, graph, verify);
+        } catch (const std::runtime_error& e) {
+            std::cerr << "Uwaga: " << e.what() << ", odbudowuje cache\n";
+        }
+    }
+
+    GraphMeta meta = loadGraph(grPath, graph);
+    saveGraphBinary(cachePath, graph, meta, grPath);
+    return meta;
+}
@@ -0,0 +1,42 @@
+//binarny format grafu (cache pliku .gr) ladowany bez kopiowania przez mmap
+#pragma once
+#include <string>
+#include <cstdint>
+#include "graph.h"
+
+//naglowek pliku; za nim (wyrownane do 64 bajtow) leza tablice
+//offsets (n+2 x int32) oraz luki (arcCount x {to, w} jako int32)
+struct GraphFileHeader {
+    char magic[8]; //"AODGRAPH"
+    std::uint32_t version;
+    std::uint32_t headerSize;
+    std::int32_t n; //GraphMeta
+    std::int32_t m;
+    std::int32_t minCost;
+    std::int32_t maxCost;
+    std::uint64_t arcCount;
+    std::uint64_t offsetsPos; //pozycja tablicy offsets w pliku
+    std::uint64_t arcsPos; //pozycja tablicy lukow w pliku
+    std::uint64_t sourceSize; //rozmiar i czas modyfikacji pliku .gr, z ktorego powstal cache
+    std::int64_t sourceMtime;
+    std::uint64_t checksum; //suma kontrolna tablic offsets i lukow
+};
+
+constexpr std::uint32_t GRAPH_FILE_VERSION = 1;
+
+//rozmiar i czas modyfikacji pliku zrodlowego (0, 0 gdy go nie ma); zapisywane
+//w plikach liczonych z grafu, zeby odrzucic te, ktore powstaly dla innego .gr
+void sourceStamp(const std::string& path, std::uint64_t& size, std::int64_t& mtime);
+
+//zapisuje graf w formacie binarnym (przez plik tymczasowy i rename)
+void saveGraphBinary(const std::string& path, const Graph& graph, const GraphMeta& meta,
+                     const std::string& sourcePath = "");
+//mapuje plik binarny i ustawia graf jako widok na niego (bez kopiowania).
+//Sprawdzany jest naglowek i rozmiary tablic; suma kontrolna tylko przy verify,
+//bo wymaga przeczytania calego pliku.
+GraphMeta loadGraphBinary(const std::string& path, Graph& graph, bool verify = false);
+
+//wczytuje graf z cache, gdy jest aktualny wzgledem pliku .gr; w przeciwnym razie
+//parsuje .gr i zapisuje cache. Pusta sciezka cache oznacza zwykle loadGraph.
+GraphMeta loadGraphCached(const std::string& grPath, const std::string& cachePath, Graph& graph,
+                          bool verify = false);
@@ -59,6 +59,13 @@ P2PQuerySet loadP2P(const std::string& path) {
                 throw std::runtime_error("blad w zaczytywaniu zapytania q: " + path);
             }
             p2p.queries.push_back(query);
+        } else if (token == "s" || token == "t") { //element zbioru zrodel/celow > s v, t v
+            int v;
+            in >> v;
+            if (!in) {
+                throw std::runtime_error("blad w zaczytywaniu linii " + token + ": " + path);
+            }
+            (token == "s" ? p2p.sources : p2p.targets).push_back(v);
         } else {
             std::getline(in, token); //skip nieznane linie
         }
@@ -72,7 +79,8 @@ void saveSS(
         const std::string& graphFile,
         const std::string& ssFile,
         const GraphMeta& meta,
-        double time) {
+        double time,
+        const SSThroughput* throughput) {
     out << "c Plik wynikowy dla problemu najkrotszej sciezki z jednym zrodlem\n";
     out << "c Algorytm: " << algoName << "\n";
     out << "p res sp ss " <<algoName << "\n";
@@ -87,6 +95,12 @@ void saveSS(
     out << "c\n";
     out << "c Sredni czas wyznaczenia najkrotszych sciezek między zrodlem a wszystkimi wierzcholkami: " << time << " ms.\n";
     out << "t " << time << "\n";
+    if (throughput) {
+        out << "c\n";
+        out << "c Liczba watkow: " << throughput->threads << "\n";
+        out << "c Czas calego przebiegu: " << throughput->wallTime << " ms.\n";
+        out << "c Przepustowosc: " << throughput->queriesPerSecond << " zapytan/s.\n";
+    }
 }
 
 void saveP2P(
@@ -110,15 +124,3 @@ void saveP2P(
     out << "c\n";
     out << "c dlugosci najkrotszych sciezek\n";
 }
-
-void saveP2PResults(
-        std::ostream& out,
-        int s,
-        int t,
-        Distance d) {
-    if (d >= INF / 2) {
-        out << "u " << s << " " << t << " INF\n";
-    } else {
-        out << "d " << s << " " << t << " " << d << "\n";
-    }
-}
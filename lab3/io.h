@@ -11,6 +11,13 @@ struct SingleSourceSet {
     std::vector<long long> sources;
 };
 
+//przepustowosc przebiegu ss (wypisywana jako komentarze pod linia t)
+struct SSThroughput {
+    int threads;
+    double wallTime; //[ms]
+    double queriesPerSecond;
+};
+
 SingleSourceSet loadSS(const std::string& path);
 void saveSS(
         std::ostream& out,
@@ -18,7 +25,8 @@ void saveSS(
         const std::string& graphFile,
         const std::string& ssFile,
         const GraphMeta& meta,
-        double time);
+        double time,
+        const SSThroughput* throughput = nullptr);
 
 struct PairQuery {
     int s;
@@ -26,6 +34,11 @@ struct PairQuery {
 };
 struct P2PQuerySet {
     std::vector<PairQuery> queries;
+    //zbiory dla macierzy odleglosci (linie "s v" i "t v"), liczonej dla kazdej pary
+    std::vector<int> sources;
+    std::vector<int> targets;
+
+    bool hasTable() const { return !sources.empty() && !targets.empty(); }
 };
 
 P2PQuerySet loadP2P(const std::string& path);
@@ -34,8 +47,4 @@ void saveP2P(
         const std::string& graphFile,
         const std::string& p2pFile,
         const GraphMeta& meta);
-void saveP2PResults(
-        std::ostream& out,
-        int s,
-        int t,
-        Distance d);
+
@@ -0,0 +1,153 @@
+//preprocessing landmarkow dla ALT
+#include "landmarks.h"
+#include "algo.h"
+#include "graphbin.h"
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <algorithm>
+
+namespace {
+
+constexpr char LM_MAGIC[8] = {'A', 'O', 'D', 'L', 'M', 'A', 'R', 'K'};
+constexpr std::uint32_t LM_VERSION = 2;
+
+struct LandmarkFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::int32_t n;
+    std::int32_t k;
+    std::int32_t requested;
+    std::uint64_t sourceSize; //rozmiar i czas modyfikacji pliku .gr (jak w cache grafu)
+    std::int64_t sourceMtime;
+};
+
+//kopiuje odleglosci do kolumny i tablicy k x n
+void storeColumn(const std::vector<Distance>& dist, int n, int k, int i, std::vector<std::uint32_t>& table) {
+    for (int v = 1; v <= n; ++v) {
+        Distance d = dist[v];
+        table[static_cast<std::size_t>(v) * k + i] =
+            (d >= INF || d >= static_cast<Distance>(LM_UNKNOWN)) ? LM_UNKNOWN : static_cast<std::uint32_t>(d);
+    }
+}
+
+} // namespace
+
+void selectLandmarks(const Graph& g, const Graph& rg, int k, Landmarks& lm) {
+    const int n = g.n();
+    if (k < 1) {
+        throw std::runtime_error("liczba landmarkow musi byc dodatnia");
+    }
+    lm.requested = k;
+    k = std::min(k, n);
+
+    lm.k = k;
+    lm.n = n;
+    lm.ids.clear();
+    lm.from.assign(static_cast<std::size_t>(n + 1) * k, LM_UNKNOWN);
+    lm.to.assign(static_cast<std::size_t>(n + 1) * k, LM_UNKNOWN);
+
+    //minimalna odleglosc od juz wybranych landmarkow (INF = nieosiagalny z zadnego)
+    std::vector<Distance> nearest(n + 1, INF);
+    QueryWorkspace ws;
+    const auto& dist = ws.dist;
+
+    //pierwszy landmark: najdalszy wierzcholek od wierzcholka 1
+    dijkstra(g, 1, ws);
+    int next = 1;
+    for (int v = 1; v <= n; ++v) {
+        if (dist[v] < INF && dist[v] > dist[next]) next = v;
+    }
+
+    for (int i = 0; i < k; ++i) {
+        lm.ids.push_back(next);
+
+        dijkstra(g, next, ws);
+        storeColumn(dist, n, k, i, lm.from);
+        for (int v = 1; v <= n; ++v) {
+            nearest[v] = std::min(nearest[v], dist[v]);
+        }
+
+        dijkstra(rg, next, ws);
+        storeColumn(dist, n, k, i, lm.to);
+
+        //kolejny: najpierw wierzcholki nieosiagalne z zadnego landmarku, potem najdalszy
+        int cand = -1;
+        for (int v = 1; v <= n; ++v) {
+            if (nearest[v] == 0) continue;
+            if (cand == -1 || nearest[v] > nearest[cand]) cand = v;
+        }
+        if (cand == -1) break; //kazdy wierzcholek jest juz landmarkiem
+        next = cand;
+    }
+
+    if (static_cast<int>(lm.ids.size()) < k) {
+        //mniej landmarkow niz zadano: zmniejsz tablice do faktycznej liczby
+        int used = static_cast<int>(lm.ids.size());
+        std::vector<std::uint32_t> from(static_cast<std::size_t>(n + 1) * used);
+        std::vector<std::uint32_t> to(static_cast<std::size_t>(n + 1) * used);
+        for (int v = 0; v <= n; ++v) {
+            for (int i = 0; i < used; ++i) {
+                from[static_cast<std::size_t>(v) * used + i] = lm.from[static_cast<std::size_t>(v) * k + i];
+                to[static_cast<std::size_t>(v) * used + i] = lm.to[static_cast<std::size_t>(v) * k + i];
+            }
+        }
+        lm.from.swap(from);
+        lm.to.swap(to);
+        lm.k = used;
+    }
+}
+
+void saveLandmarks(const std::string& path, const Landmarks& lm, const std::string& graphPath) {
+    LandmarkFileHeader h{};
+    std::memcpy(h.magic, LM_MAGIC, sizeof(LM_MAGIC));
+    h.version = LM_VERSION;
+    h.n = lm.n;
+    h.k = lm.k;
+    h.requested = lm.requested;
+    sourceStamp(graphPath, h.sourceSize, h.sourceMtime);
+
+    const std::string tmpPath = path + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Nie moge utworzyc pliku: " + tmpPath);
+    }
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(lm.ids.data()), static_cast<std::streamsize>(lm.ids.size() * sizeof(int)));
+    out.write(reinterpret_cast<const char*>(lm.from.data()), static_cast<std::streamsize>(lm.from.size() * sizeof(std::uint32_t)));
+    out.write(reinterpret_cast<const char*>(lm.to.data()), static_cast<std::streamsize>(lm.to.size() * sizeof(std::uint32_t)));
+    out.close();
+    if (!out || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("Nie moge zapisac pliku: " + path);
+    }
+}
+
+bool loadLandmarks(const std::string& path, const std::string& graphPath, int n, int k, Landmarks& lm) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    LandmarkFileHeader h;
+    in.read(reinterpret_cast<char*>(&h), sizeof(h));
+    std::uint64_t size;
+    std::int64_t mtime;
+    sourceStamp(graphPath, size, mtime);
+    if (!in || std::memcmp(h.magic, LM_MAGIC, sizeof(LM_MAGIC)) != 0 || h.version != LM_VERSION
+        || h.n != n || h.requested != k || h.k < 1 || h.k > k
+        || h.sourceSize != size || h.sourceMtime != mtime) {
+        return false;
+    }
+
+    const std::size_t cells = static_cast<std::size_t>(n + 1) * h.k;
+    lm.n = h.n;
+    lm.k = h.k;
+    lm.requested = h.requested;
+    lm.ids.resize(h.k);
+    lm.from.resize(cells);
+    lm.to.resize(cells);
+    in.read(reinterpret_cast<char*>(lm.ids.data()), static_cast<std::streamsize>(lm.ids.size() * sizeof(int)));
+    in.read(reinterpret_cast<char*>(lm.from.data()), static_cast<std::streamsize>(cells * sizeof(std::uint32_t)));
+    in.read(reinterpret_cast<char*>(lm.to.data()), static_cast<std::streamsize>(cells * sizeof(std::uint32_t)));
+    return static_cast<bool>(in);
+}
@@ -0,0 +1,52 @@
+//landmarki dla A* (ALT): wybor wierzcholkow, tablice odleglosci i ich zapis na dysk
+#pragma once
+#include <vector>
+#include <string>
+#include <cstdint>
+#include "common.h"
+#include "graph.h"
+
+//odleglosci sa trzymane jako 32-bitowe liczby bez znaku, zeby tablice K x n
+//miescily sie w pamieci dla USA-road-t; LM_UNKNOWN oznacza brak sciezki
+//albo odleglosc poza zakresem (taki wpis jest pomijany przy liczeniu ograniczen)
+constexpr std::uint32_t LM_UNKNOWN = 0xFFFFFFFFu;
+
+struct Landmarks {
+    int k = 0; //liczba landmarkow
+    int requested = 0; //liczba zadana przy wyborze (k moze byc mniejsze dla malych grafow)
+    int n = 0; //liczba wierzcholkow grafu
+    std::vector<int> ids; //wybrane wierzcholki
+    std::vector<std::uint32_t> from; //from[v*k + i] = d(L_i, v)
+    std::vector<std::uint32_t> to; //to[v*k + i] = d(v, L_i)
+
+    //dolne ograniczenie odleglosci d(v, t) z nierownosci trojkata
+    Distance lowerBound(int v, int t) const {
+        const std::uint32_t* fv = &from[static_cast<std::size_t>(v) * k];
+        const std::uint32_t* ft = &from[static_cast<std::size_t>(t) * k];
+        const std::uint32_t* tv = &to[static_cast<std::size_t>(v) * k];
+        const std::uint32_t* tt = &to[static_cast<std::size_t>(t) * k];
+        Distance best = 0;
+        for (int i = 0; i < k; ++i) {
+            //d(v,L) - d(t,L) <= d(v,t)
+            if (tv[i] != LM_UNKNOWN && tt[i] != LM_UNKNOWN) {
+                best = std::max<Distance>(best, static_cast<Distance>(tv[i]) - tt[i]);
+            }
+            //d(L,t) - d(L,v) <= d(v,t)
+            if (ft[i] != LM_UNKNOWN && fv[i] != LM_UNKNOWN) {
+                best = std::max<Distance>(best, static_cast<Distance>(ft[i]) - fv[i]);
+            }
+        }
+        return best;
+    }
+};
+
+//wybiera k landmarkow metoda "farthest" (kazdy kolejny jest najdalej od juz wybranych)
+//i liczy dla nich odleglosci po grafie oraz po grafie odwroconym
+void selectLandmarks(const Graph& g, const Graph& rg, int k, Landmarks& lm);
+
+//graphPath to plik .gr, z ktorego policzono landmarki (jego rozmiar i czas modyfikacji
+//trafiaja do naglowka)
+void saveLandmarks(const std::string& path, const Landmarks& lm, const std::string& graphPath);
+//false, gdy pliku nie ma albo nie pasuje do grafu (inny plik .gr, inna liczba
+//wierzcholkow lub zadanych landmarkow)
+bool loadLandmarks(const std::string& path, const std::string& graphPath, int n, int k, Landmarks& lm);
@@ -0,0 +1,187 @@
+//implementacja tablic odleglosci many-to-many
+#include "m2m.h"
+#include "algo.h"
+#include <queue>
+#include <functional>
+#include <fstream>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+#include <algorithm>
+
+namespace {
+
+constexpr char TABLE_MAGIC[8] = {'A', 'O', 'D', 'M', 'A', 'T', 'R', 'X'};
+constexpr std::uint32_t TABLE_VERSION = 1;
+
+struct TableFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t rows;
+    std::uint32_t cols;
+    std::uint32_t reserved;
+};
+
+using P = std::pair<Distance, int>; //para (odleglosc, wierzcholek)
+using Queue = std::priority_queue<P, std::vector<P>, std::greater<P>>;
+
+bool validVertex(int v, int n) { return v >= 1 && v <= n; }
+
+//pelne wyszukiwanie w gore hierarchii ze stall-on-demand; visit(v, d) dla kazdego
+//wierzcholka, ktory nie zostal wstrzymany (tylko takie moga lezec na najkrotszej sciezce)
+template <class Visit>
+void upwardSearch(const ChGraph& graph, const ChGraph& stall, int root,
+                  std::vector<Distance>& dist, std::vector<int>& touched, Queue& q, Visit visit) {
+    for (int v : touched) dist[v] = INF;
+    touched.clear();
+    q = Queue();
+
+    dist[root] = 0;
+    touched.push_back(root);
+    q.push({0, root});
+
+    while (!q.empty()) {
+        auto [d, u] = q.top();
+        q.pop();
+        if (d > dist[u]) continue; //stary wpis w kolejce
+
+        bool stalled = false;
+        for (const auto& [x, w] : stall[u]) {
+            if (dist[x] != INF && dist[x] + w < d) {
+                stalled = true;
+                break;
+            }
+        }
+        if (stalled) continue;
+
+        visit(u, d);
+        for (const auto& [v, w] : graph[u]) {
+            Distance nd = d + w;
+            if (nd < dist[v]) {
+                if (dist[v] == INF) touched.push_back(v);
+                dist[v] = nd;
+                q.push({nd, v});
+            }
+        }
+    }
+}
+
+} // namespace
+
+void computeTableDijkstra(const Graph& g, const std::vector<int>& sources,
+                          const std::vector<int>& targets, const TableRowSink& sink) {
+    const int n = g.n();
+
+    QueryWorkspace ws;
+    ws.setTargets(targets, n);
+    std::vector<Distance> row(targets.size());
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        std::fill(row.begin(), row.end(), INF);
+        int s = sources[i];
+        if (validVertex(s, n)) {
+            dijkstra(g, s, ws);
+            for (std::size_t j = 0; j < targets.size(); ++j) {
+                if (validVertex(targets[j], n)) row[j] = ws.dist[targets[j]];
+            }
+        }
+        sink(i, row.data());
+    }
+}
+
+void computeTableCH(const ContractionHierarchy& ch, const std::vector<int>& sources,
+                    const std::vector<int>& targets, const TableRowSink& sink) {
+    const int n = ch.n;
+
+    std::vector<Distance> dist(n + 1, INF);
+    std::vector<int> touched;
+    Queue q;
+
+    //wyszukiwania wstecz od celow: wpisy (wierzcholek, cel, odleglosc)
+    struct Entry {
+        int target;
+        Distance d;
+    };
+    std::vector<int> entryVertex;
+    std::vector<Entry> raw;
+    for (std::size_t j = 0; j < targets.size(); ++j) {
+        if (!validVertex(targets[j], n)) continue;
+        upwardSearch(ch.down, ch.up, targets[j], dist, touched, q, [&](int v, Distance d) {
+            entryVertex.push_back(v);
+            raw.push_back({static_cast<int>(j), d});
+        });
+    }
+
+    //kubelki jako CSR: wpisy posortowane (stabilnie) po wierzcholku
+    std::vector<std::size_t> bucketStart(n + 2, 0);
+    for (int v : entryVertex) ++bucketStart[v + 1];
+    for (int v = 0; v <= n; ++v) bucketStart[v + 1] += bucketStart[v];
+    std::vector<Entry> buckets(raw.size());
+    {
+        std::vector<std::size_t> pos(bucketStart.begin(), bucketStart.end() - 1);
+        for (std::size_t k = 0; k < raw.size(); ++k) buckets[pos[entryVertex[k]]++] = raw[k];
+    }
+
+    //wyszukiwania w gore od zrodel, laczone z wpisami w kubelkach
+    std::vector<Distance> row(targets.size());
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        std::fill(row.begin(), row.end(), INF);
+        if (validVertex(sources[i], n)) {
+            upwardSearch(ch.up, ch.down, sources[i], dist, touched, q, [&](int v, Distance d) {
+                for (std::size_t k = bucketStart[v]; k < bucketStart[v + 1]; ++k) {
+                    const Entry& e = buckets[k];
+                    if (d + e.d < row[e.target]) row[e.target] = d + e.d;
+                }
+            });
+        }
+        sink(i, row.data());
+    }
+}
+
+void writeTableRow(ResultWriter& out, int s, const std::vector<int>& targets, const Distance* row) {
+    for (std::size_t j = 0; j < targets.size(); ++j) {
+        out.write(s, targets[j], row[j]);
+    }
+}
+
+TableBinaryWriter::TableBinaryWriter(const std::string& path, const std::vector<int>& sources,
+                                     const std::vector<int>& targets)
+    : path_(path), tmpPath_(path + ".tmp"), rows_(sources.size()), values_(targets.size()) {
+    out_.open(tmpPath_, std::ios::binary | std::ios::trunc);
+    if (!out_) {
+        throw std::runtime_error("Nie moge utworzyc pliku: " + tmpPath_);
+    }
+    TableFileHeader h{};
+    std::memcpy(h.magic, TABLE_MAGIC, sizeof(TABLE_MAGIC));
+    h.version = TABLE_VERSION;
+    h.rows = static_cast<std::uint32_t>(sources.size());
+    h.cols = static_cast<std::uint32_t>(targets.size());
+    out_.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out_.write(reinterpret_cast<const char*>(sources.data()), static_cast<std::streamsize>(sources.size() * sizeof(int)));
+    out_.write(reinterpret_cast<const char*>(targets.data()), static_cast<std::streamsize>(targets.size() * sizeof(int)));
+}
+
+TableBinaryWriter::~TableBinaryWriter() {
+    if (!closed_) {
+        out_.close();
+        std::remove(tmpPath_.c_str());
+    }
+}
+
+void TableBinaryWriter::writeRow(const Distance* row) {
+    for (std::size_t j = 0; j < values_.size(); ++j) {
+        values_[j] = row[j] >= INF / 2 ? -1 : static_cast<std::int64_t>(row[j]);
+    }
+    out_.write(reinterpret_cast<const char*>(values_.data()), static_cast<std::streamsize>(values_.size() * sizeof(std::int64_t)));
+    ++rowsWritten_;
+}
+
+void TableBinaryWriter::close() {
+    if (closed_) return;
+    closed_ = true;
+    out_.close();
+    if (!out_ || rowsWritten_ != rows_ || std::rename(tmpPath_.c_str(), path_.c_str()) != 0) {
+        std::remove(tmpPath_.c_str());
+        throw std::runtime_error("Nie moge zapisac pliku: " + path_);
+    }
+}
@@ -0,0 +1,53 @@
+//tablice odleglosci many-to-many (zbiory zrodel i celow z linii s/t pliku .p2p)
+#pragma once
+#include <vector>
+#include <string>
+#include <fstream>
+#include <functional>
+#include <cstdint>
+#include "common.h"
+#include "graph.h"
+#include "ch.h"
+#include "resultwriter.h"
+
+//wiersz macierzy S x T: row[j] = d(sources[i], targets[j]), INF gdy sciezki nie ma
+//(albo wierzcholek spoza grafu); wiersze sa oddawane po kolei (i = 0, 1, ...) zaraz
+//po policzeniu, wiec zapis moze trwac rownolegle z liczeniem nastepnych
+using TableRowSink = std::function<void(std::size_t i, const Distance* row)>;
+
+//Dijkstra z kazdego zrodla, przerywany, gdy wszystkie cele sa juz ustalone
+void computeTableDijkstra(const Graph& g, const std::vector<int>& sources,
+                          const std::vector<int>& targets, const TableRowSink& sink);
+
+//algorytm kubelkowy na hierarchii skrotow: wyszukiwania w gore od kazdego celu
+//(po grafie down) zostawiaja w odwiedzonych wierzcholkach wpisy (cel, odleglosc),
+//a wyszukiwanie w gore od zrodla laczy sie z nimi, wiec kazdy wierzcholek
+//zrodlowy i docelowy jest przeszukiwany tylko raz zamiast S * T zapytan p2p
+void computeTableCH(const ContractionHierarchy& ch, const std::vector<int>& sources,
+                    const std::vector<int>& targets, const TableRowSink& sink);
+
+//linie d/u dla jednego wiersza (zrodlo s i wszystkie cele), jak dla zapytan q
+void writeTableRow(ResultWriter& out, int s, const std::vector<int>& targets, const Distance* row);
+
+//gesta macierz binarna: naglowek, id zrodel, id celow, odleglosci int64 (-1 = brak
+//sciezki) wiersz po wierszu; plik pojawia sie pod docelowa nazwa dopiero po close()
+class TableBinaryWriter {
+public:
+    TableBinaryWriter(const std::string& path, const std::vector<int>& sources, const std::vector<int>& targets);
+    ~TableBinaryWriter(); //bez close() plik tymczasowy jest usuwany
+    TableBinaryWriter(const TableBinaryWriter&) = delete;
+    TableBinaryWriter& operator=(const TableBinaryWriter&) = delete;
+
+    void writeRow(const Distance* row);
+    //rzuca wyjatek, gdy zapis sie nie udal albo brakuje wierszy
+    void close();
+
+private:
+    std::string path_;
+    std::string tmpPath_;
+    std::ofstream out_;
+    std::size_t rows_;
+    std::size_t rowsWritten_ = 0;
+    std::vector<std::int64_t> values_; //jeden wiersz
+    bool closed_ = false;
+};
@@ -0,0 +1,34 @@
+//mapowanie plikow do pamieci
+#include "mapped.h"
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+MappedFile::MappedFile(const std::string& path, bool sequential) {
+    fd_ = ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        throw std::runtime_error("Nie moge otworzyc pliku: " + path);
+    }
+    struct stat st;
+    if (::fstat(fd_, &st) != 0) {
+        ::close(fd_);
+        throw std::runtime_error("Nie moge odczytac rozmiaru pliku: " + path);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+    if (size_ > 0) {
+        void* p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (p == MAP_FAILED) {
+            ::close(fd_);
+            throw std::runtime_error("Nie moge zmapowac pliku: " + path);
+        }
+        ::madvise(p, size_, sequential ? MADV_SEQUENTIAL : MADV_WILLNEED);
+        data_ = static_cast<const char*>(p);
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data_) ::munmap(const_cast<char*>(data_), size_);
+    ::close(fd_);
+}
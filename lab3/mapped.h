@@ -0,0 +1,22 @@
+//plik zmapowany do pamieci (mmap) tylko do odczytu
+#pragma once
+#include <string>
+#include <cstddef>
+
+class MappedFile {
+public:
+    //sequential = true podpowiada jadru czytanie po kolei (parser .gr)
+    explicit MappedFile(const std::string& path, bool sequential = false);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* begin() const { return data_; }
+    const char* end() const { return data_ + size_; }
+    std::size_t size() const { return size_; }
+
+private:
+    int fd_ = -1;
+    const char* data_ = nullptr;
+    std::size_t size_ = 0;
+};
@@ -0,0 +1,104 @@
+//implementacja silnikow punkt-punkt
+#include "p2p.h"
+#include <algorithm>
+
+BidirectionalDijkstra::BidirectionalDijkstra(const Graph& g, const Graph& rg)
+    : g_(g), rg_(rg), distF_(g.n()+1, INF), distB_(g.n()+1, INF) {}
+
+void BidirectionalDijkstra::reset() {
+    for (int v : touched_) {
+        distF_[v] = INF;
+        distB_[v] = INF;
+    }
+    touched_.clear();
+    qF_ = Queue();
+    qB_ = Queue();
+}
+
+Distance BidirectionalDijkstra::query(int s, int t) {
+    if (s == t) return 0;
+    reset();
+
+    distF_[s] = 0;
+    distB_[t] = 0;
+    touched_.push_back(s);
+    touched_.push_back(t);
+    qF_.push({0, s});
+    qB_.push({0, t});
+
+    Distance best = INF; //najkrotsza znaleziona sciezka s->t
+
+    //jeden krok w kierunku: zdejmij minimum i zrelaksuj luki
+    auto step = [&](Queue& q, const Graph& graph, std::vector<Distance>& dist, const std::vector<Distance>& other) {
+        auto [d, u] = q.top();
+        q.pop();
+        if (d > dist[u]) return; //stary wpis w kolejce
+
+        for (const auto& [v, w] : graph[u]) {
+            Distance nd = d + w;
+            if (nd < dist[v]) {
+                if (dist[v] == INF && other[v] == INF) touched_.push_back(v);
+                dist[v] = nd;
+                q.push({nd, v});
+            }
+            if (other[v] != INF && nd + other[v] < best) {
+                best = nd + other[v];
+            }
+        }
+    };
+
+    while (!qF_.empty() && !qB_.empty()) {
+        //warunek stopu: zadna sciezka przez nieprzetworzone wierzcholki nie jest krotsza
+        if (qF_.top().first + qB_.top().first >= best) break;
+
+        if (qF_.top().first <= qB_.top().first) {
+            step(qF_, g_, distF_, distB_);
+        } else {
+            step(qB_, rg_, distB_, distF_);
+        }
+    }
+    return best;
+}
+
+AltSearch::AltSearch(const Graph& g, const Landmarks& lm)
+    : g_(g), lm_(lm), dist_(g.n()+1, INF), pot_(g.n()+1, -1) {}
+
+void AltSearch::reset() {
+    for (int v : touched_) {
+        dist_[v] = INF;
+        pot_[v] = -1;
+    }
+    touched_.clear();
+    q_ = Queue();
+}
+
+Distance AltSearch::query(int s, int t) {
+    if (s == t) return 0;
+    reset();
+
+    dist_[s] = 0;
+    pot_[s] = lm_.lowerBound(s, t);
+    touched_.push_back(s);
+    q_.push({pot_[s], s});
+
+    while (!q_.empty()) {
+        auto [key, u] = q_.top();
+        q_.pop();
+        Distance du = dist_[u];
+        if (key > du + pot_[u]) continue; //stary wpis w kolejce
+        if (u == t) break; //potencjal dopuszczalny, wiec d(s,t) jest juz ostateczne
+
+        for (const auto& [v, w] : g_[u]) {
+            Distance nd = du + w;
+            if (nd < dist_[v]) {
+                if (pot_[v] < 0) {
+                    pot_[v] = lm_.lowerBound(v, t);
+                    touched_.push_back(v);
+                }
+                dist_[v] = nd;
+                q_.push({nd + pot_[v], v});
+            }
+        }
+    }
+    return dist_[t];
+}
@@ -0,0 +1,56 @@
+//silniki zapytan punkt-punkt (bez liczenia calego drzewa najkrotszych sciezek)
+#pragma once
+#include <vector>
+#include <queue>
+#include <utility>
+#include <functional>
+#include "common.h"
+#include "graph.h"
+#include "landmarks.h"
+
+//dwukierunkowy Dijkstra: jednoczesnie od s po grafie i od t po grafie odwroconym,
+//konczy, gdy suma minimow obu kolejek nie moze juz poprawic najlepszej sciezki.
+//Tablice odleglosci sa czyszczone tylko w odwiedzonych wierzcholkach,
+//wiec koszt zapytania zalezy od przeszukanej czesci grafu, a nie od n.
+class BidirectionalDijkstra {
+public:
+    BidirectionalDijkstra(const Graph& g, const Graph& rg);
+
+    Distance query(int s, int t);
+
+private:
+    using P = std::pair<Distance, int>; //para (odleglosc, wierzcholek)
+    using Queue = std::priority_queue<P, std::vector<P>, std::greater<P>>;
+
+    void reset();
+
+    const Graph& g_;
+    const Graph& rg_;
+    std::vector<Distance> distF_; //odleglosci od s
+    std::vector<Distance> distB_; //odleglosci do t
+    std::vector<int> touched_; //wierzcholki z dist != INF w ktorymkolwiek kierunku
+    Queue qF_;
+    Queue qB_;
+};
+
+//A* z potencjalami z landmarkow (ALT): klucz w kolejce to d(s,v) + dolne
+//ograniczenie d(v,t), wiec przeszukiwanie skupia sie w kierunku celu
+class AltSearch {
+public:
+    AltSearch(const Graph& g, const Landmarks& lm);
+
+    Distance query(int s, int t);
+
+private:
+    using P = std::pair<Distance, int>; //para (klucz, wierzcholek)
+    using Queue = std::priority_queue<P, std::vector<P>, std::greater<P>>;
+
+    void reset();
+
+    const Graph& g_;
+    const Landmarks& lm_;
+    std::vector<Distance> dist_;
+    std::vector<Distance> pot_; //potencjal liczony przy pierwszym dotknieciu (-1 = brak)
+    std::vector<int> touched_;
+    Queue q_;
+};
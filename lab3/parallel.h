@@ -0,0 +1,118 @@
+//rownolegle wykonanie niezaleznych zapytan ss na wspoldzielonym grafie
+#pragma once
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <exception>
+
+//podsumowanie przebiegu po wszystkich zrodlach
+struct SourceTimings {
+    std::size_t count = 0; //liczba zapytan
+    int threads = 1; //liczba watkow roboczych
+    double avgTime = 0.0; //sredni czas jednego zapytania [ms]
+    double wallTime = 0.0; //czas calego przebiegu [ms]
+    double throughput = 0.0; //zapytania na sekunde
+    std::vector<double> latencies; //czasy kolejnych zapytan [ms] (kolejnosc zakonczenia)
+};
+
+//liczba watkow dla opcji -threads (0 = wszystkie rdzenie)
+inline int resolveThreads(int requested) {
+    if (requested > 0) return requested;
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+//uruchamia run(state, s) dla kazdego zrodla na puli `threads` watkow; kazdy watek
+//ma wlasny stan State (tablica odleglosci, kolejka), graf jest tylko czytany.
+//Zrodla sa rozdzielane dynamicznie przez licznik atomowy. Po ostatnim zapytaniu
+//watku wywolywane jest finish(state), np. do zebrania licznikow. Wyjatek z run
+//albo finish zatrzymuje rozdzielanie zrodel i jest rzucany dalej po join.
+template <class State, class Run, class Finish>
+SourceTimings runSources(const std::vector<long long>& sources, int threads, Run run, Finish finish) {
+    using Clock = std::chrono::high_resolution_clock;
+
+    SourceTimings result;
+    result.count = sources.size();
+    result.threads = std::max(1, std::min<int>(threads, static_cast<int>(sources.size())));
+
+    std::atomic<std::size_t> next{0};
+    //wyniki watkow zapisywane raz na koniec, zeby sasiednie sloty nie dzielily
+    //linii cache w trakcie pomiaru
+    std::vector<double> busy(result.threads, 0.0); //suma czasow zapytan na watek
+    std::vector<std::vector<double>> latencies(result.threads);
+    std::vector<std::exception_ptr> errors(result.threads);
+
+    auto worker = [&](int id) {
+        double localBusy = 0.0;
+        std::vector<double> localLatencies;
+        try {
+            State state;
+            for (std::size_t i = next++; i < sources.size(); i = next++) {
+                auto start = Clock::now();
+                run(state, static_cast<int>(sources[i]));
+                auto end = Clock::now();
+                double ms = std::chrono::duration<double, std::milli>(end - start).count();
+                localBusy += ms;
+                localLatencies.push_back(ms);
+            }
+            finish(state);
+        } catch (...) {
+            errors[id] = std::current_exception();
+            next = sources.size(); //pozostale watki koncza po biezacym zapytaniu
+        }
+        busy[id] = localBusy;
+        latencies[id] = std::move(localLatencies);
+    };
+
+    auto wallStart = Clock::now();
+    std::vector<std::thread> pool;
+    for (int id = 1; id < result.threads; ++id) {
+        pool.emplace_back(worker, id);
+    }
+    worker(0);
+    for (auto& t : pool) t.join();
+    auto wallEnd = Clock::now();
+    for (const auto& e : errors) {
+        if (e) std::rethrow_exception(e);
+    }
+
+    double elapsed = 0.0;
+    for (double b : busy) elapsed += b;
+    for (const auto& l : latencies) result.latencies.insert(result.latencies.end(), l.begin(), l.end());
+    result.avgTime = result.count ? elapsed / result.count : 0.0;
+    result.wallTime = std::chrono::duration<double, std::milli>(wallEnd - wallStart).count();
+    result.throughput = result.wallTime > 0 ? result.count / (result.wallTime / 1000.0) : 0.0;
+    return result;
+}
+
+template <class State, class Run>
+SourceTimings runSources(const std::vector<long long>& sources, int threads, Run run) {
+    return runSources<State>(sources, threads, run, [](State&) {});
+}
+
+//bariera dla stalej grupy watkow; ostatni przybywajacy wykonuje `complete`
+//przed zwolnieniem pozostalych (jak std::barrier z C++20). Czekajace watki
+//oddaja procesor przez yield, wiec dziala tez przy wiekszej liczbie watkow niz rdzeni.
+class SpinBarrier {
+public:
+    explicit SpinBarrier(int count) : count_(count) {}
+
+    template <class Complete>
+    void arriveAndWait(Complete complete) {
+        unsigned gen = generation_.load(std::memory_order_acquire);
+        if (arrived_.fetch_add(1, std::memory_order_acq_rel) + 1 == count_) {
+            complete();
+            arrived_.store(0, std::memory_order_relaxed);
+            generation_.store(gen + 1, std::memory_order_release);
+        } else {
+            while (generation_.load(std::memory_order_acquire) == gen) std::this_thread::yield();
+        }
+    }
+    void arriveAndWait() { arriveAndWait([] {}); }
+
+private:
+    const int count_;
+    std::atomic<int> arrived_{0};
+    std::atomic<unsigned> generation_{0};
+};
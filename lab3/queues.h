@@ -0,0 +1,669 @@
+//struktury kolejek priorytetowych uzywane przez algorytmy najkrotszych sciezek
+#pragma once
+#include <vector>
+#include <utility>
+#include <cassert>
+#include <stdexcept>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+#include "stats.h"
+
+//numer najstarszego ustawionego bitu x != 0 dla 32- i 64-bitowych kluczy radix heap
+template <class U>
+inline int highestBit(U x) {
+    static_assert(std::is_unsigned<U>::value && (sizeof(U) == 4 || sizeof(U) == 8), "klucz 32- albo 64-bitowy");
+    if constexpr (sizeof(U) == 4) return 31 - __builtin_clz(x);
+    else return 63 - __builtin_clzll(x);
+}
+
+//kubelki 0..BITS dla klucza o BITS bitach (65 dla Distance, 33 dla Distance32)
+template <class Key>
+struct RadixHeap {
+    using U = std::make_unsigned_t<Key>;
+    static constexpr int BITS = static_cast<int>(sizeof(U) * 8);
+
+    std::vector<std::pair<U,int>> buckets[BITS + 1];
+    U last;
+    std::size_t sz; //ilosc elementow w kubelkach
+    std::size_t pulls = 0; //liczniki pull() (zwiekszane tylko z LAB3_STATS)
+    std::size_t moved = 0;
+
+    RadixHeap() : last(0), sz(0) {}
+
+    //oproznia kopiec, kubelki zachowuja zaalokowana pamiec
+    void clear() {
+        for (auto& b : buckets) b.clear();
+        last = 0;
+        sz = 0;
+    }
+
+    bool empty() const { return sz == 0; }
+    std::size_t size() const { return sz; }
+
+    //dodanie elemetu o kluczu `key` i wartosci `v` do kubelkow
+    void push(Key key, int v) {
+        U x = static_cast<U>(key);
+        assert(x >= last);
+
+        int b = bucketIndex(x);
+        buckets[b].emplace_back(x, v);
+        ++sz;
+    }
+    //zwraca element o najmniejszym kluczu (z zerowego kubelka)
+    std::pair<Key,int> top() {
+        if (buckets[0].empty()) pull();
+        const auto &p = buckets[0].back();
+        return { static_cast<Key>(p.first), p.second };
+    }
+    //usuwa element o najmniejszym kluczu (z zerowego kubelka)
+    void pop() {
+        if (buckets[0].empty()) pull();
+        buckets[0].pop_back();
+        --sz;
+    }
+
+private:
+    //znajdz indeks kubelka dla klucza x
+    int bucketIndex(U x) const {
+        if (x == last) return 0;
+        return highestBit(x ^ last) + 1; // bucket 1..BITS
+    }
+
+    //przeniesienie elementow z niepustego kubelka i > 0 do odpowiednich kubelkow
+    void pull() {
+        int i = 1;
+        while (i <= BITS && buckets[i].empty()) ++i;
+        if(i > BITS){
+            throw std::runtime_error("RadixHeap pull() called on empty heap");
+        }
+
+        U new_last = buckets[i][0].first;
+        for (auto &p : buckets[i]) {
+            if (p.first < new_last) new_last = p.first;
+        }
+        last = new_last;
+        LAB3_STATS_ONLY(++pulls; moved += buckets[i].size();)
+
+        for (auto &p : buckets[i]) {
+            int b = bucketIndex(p.first);
+            buckets[b].push_back(p);
+        }
+        buckets[i].clear();
+    }
+};
+
+//radix heap z kubelkami wielokrotnego uzytku: kazdy kubelek pamieta najmniejszy
+//klucz, a maska niepustych kubelkow daje nastepny kubelek przez ctz, wiec pull()
+//przechodzi kubelek tylko raz. Przenoszony kubelek trafia do bufora (swap), wiec
+//zadna pamiec nie jest zwalniana ani alokowana po rozgrzaniu.
+template <class Key>
+class PooledRadixHeap {
+public:
+    using U = std::make_unsigned_t<Key>;
+    static constexpr int BITS = static_cast<int>(sizeof(U) * 8);
+    std::size_t pulls = 0; //liczniki pull() (zwiekszane tylko z LAB3_STATS)
+    std::size_t moved = 0;
+
+    //oproznia kopiec, kubelki zachowuja zaalokowana pamiec
+    void clear() {
+        buckets_[0].clear();
+        for (std::uint64_t m = mask_; m; m &= m - 1) buckets_[__builtin_ctzll(m) + 1].clear();
+        mask_ = 0;
+        last_ = 0;
+        sz_ = 0;
+    }
+
+    bool empty() const { return sz_ == 0; }
+    std::size_t size() const { return sz_; }
+
+    void push(Key key, int v) {
+        U x = static_cast<U>(key);
+        assert(x >= last_);
+        place(x, v);
+        ++sz_;
+    }
+    //zwraca element o najmniejszym kluczu (z zerowego kubelka)
+    std::pair<Key,int> top() {
+        if (buckets_[0].empty()) pull();
+        const auto& p = buckets_[0].back();
+        return { static_cast<Key>(p.first), p.second };
+    }
+    //usuwa element o najmniejszym kluczu (z zerowego kubelka)
+    void pop() {
+        if (buckets_[0].empty()) pull();
+        buckets_[0].pop_back();
+        --sz_;
+    }
+
+private:
+    std::vector<std::pair<U,int>> buckets_[BITS + 1];
+    U minKey_[BITS + 1] = {}; //najmniejszy klucz w kubelku (wazny, gdy kubelek niepusty)
+    std::uint64_t mask_ = 0; //bit b-1 = kubelek b > 0 niepusty
+    std::vector<std::pair<U,int>> scratch_; //bufor przenoszonego kubelka
+    U last_ = 0;
+    std::size_t sz_ = 0;
+
+    void place(U x, int v) {
+        if (x == last_) {
+            buckets_[0].emplace_back(x, v);
+            return;
+        }
+        int b = highestBit(x ^ last_) + 1; //1..BITS
+        std::uint64_t bit = 1ULL << (b - 1);
+        if (!(mask_ & bit) || x < minKey_[b]) minKey_[b] = x;
+        mask_ |= bit;
+        buckets_[b].emplace_back(x, v);
+    }
+
+    //przeniesienie najnizszego niepustego kubelka i > 0 do kubelkow nizszych
+    void pull() {
+        if (!mask_) {
+            throw std::runtime_error("PooledRadixHeap pull() called on empty heap");
+        }
+        int i = __builtin_ctzll(mask_) + 1;
+        last_ = minKey_[i];
+        mask_ &= mask_ - 1;
+        scratch_.swap(buckets_[i]);
+        LAB3_STATS_ONLY(++pulls; moved += scratch_.size();)
+        for (const auto& p : scratch_) place(p.first, p.second);
+        scratch_.clear();
+    }
+};
+
+//radix heap o cyfrach 8-bitowych: kubelek wyznacza najstarszy bajt, w ktorym klucz
+//rozni sie od `last`, oraz wartosc tego bajtu w kluczu (poziom na kazdy bajt klucza,
+//po 256 kubelkow). Element schodzi najwyzej o jeden poziom przy kazdym przeniesieniu,
+//wiec jest przenoszony co najwyzej 8 razy zamiast 64 (4 razy dla kluczy 32-bitowych).
+template <class Key>
+class TwoLevelRadixHeap {
+public:
+    using U = std::make_unsigned_t<Key>;
+    std::size_t pulls = 0; //liczniki pull() (zwiekszane tylko z LAB3_STATS)
+    std::size_t moved = 0;
+    static constexpr int LEVELS = static_cast<int>(sizeof(U)); //jeden poziom na bajt klucza
+    static constexpr int DIGITS = 256;
+
+    //oproznia kopiec, kubelki zachowuja zaalokowana pamiec
+    void clear() {
+        zero_.clear();
+        for (unsigned lm = levelMask_; lm; lm &= lm - 1) {
+            int level = __builtin_ctz(lm);
+            for (int w = 0; w < DIGITS / 64; ++w) {
+                for (std::uint64_t m = digitMask_[level][w]; m; m &= m - 1) {
+                    buckets_[level * DIGITS + w * 64 + __builtin_ctzll(m)].clear();
+                }
+                digitMask_[level][w] = 0;
+            }
+        }
+        levelMask_ = 0;
+        last_ = 0;
+        sz_ = 0;
+    }
+
+    bool empty() const { return sz_ == 0; }
+    std::size_t size() const { return sz_; }
+
+    void push(Key key, int v) {
+        U x = static_cast<U>(key);
+        assert(x >= last_);
+        place(x, v);
+        ++sz_;
+    }
+    //zwraca element o najmniejszym kluczu (klucz == last)
+    std::pair<Key,int> top() {
+        if (zero_.empty()) pull();
+        const auto& p = zero_.back();
+        return { static_cast<Key>(p.first), p.second };
+    }
+    //usuwa element o najmniejszym kluczu (klucz == last)
+    void pop() {
+        if (zero_.empty()) pull();
+        zero_.pop_back();
+        --sz_;
+    }
+
+private:
+    std::vector<std::pair<U,int>> zero_; //klucze rowne last
+    std::vector<std::pair<U,int>> buckets_[LEVELS * DIGITS];
+    U minKey_[LEVELS * DIGITS] = {};
+    std::uint64_t digitMask_[LEVELS][DIGITS / 64] = {}; //niepuste kubelki poziomu
+    unsigned levelMask_ = 0; //niepuste poziomy
+    std::vector<std::pair<U,int>> scratch_;
+    U last_ = 0;
+    std::size_t sz_ = 0;
+
+    void place(U x, int v) {
+        if (x == last_) {
+            zero_.emplace_back(x, v);
+            return;
+        }
+        int level = highestBit(x ^ last_) >> 3;
+        int digit = static_cast<int>((x >> (level * 8)) & 0xff);
+        int b = level * DIGITS + digit;
+        std::uint64_t& word = digitMask_[level][digit >> 6];
+        std::uint64_t bit = 1ULL << (digit & 63);
+        if (!(word & bit) || x < minKey_[b]) minKey_[b] = x;
+        word |= bit;
+        levelMask_ |= 1u << level;
+        buckets_[b].emplace_back(x, v);
+    }
+
+    //przeniesienie kubelka o najmniejszej cyfrze z najnizszego niepustego poziomu;
+    //jego elementy roznia sie od nowego last dopiero na nizszych poziomach
+    void pull() {
+        if (!levelMask_) {
+            throw std::runtime_error("TwoLevelRadixHeap pull() called on empty heap");
+        }
+        int level = __builtin_ctz(levelMask_);
+        int w = 0;
+        while (!digitMask_[level][w]) ++w;
+        int digit = w * 64 + __builtin_ctzll(digitMask_[level][w]);
+        int b = level * DIGITS + digit;
+
+        digitMask_[level][w] &= digitMask_[level][w] - 1;
+        bool levelEmpty = true;
+        for (int k = 0; k < DIGITS / 64; ++k) {
+            if (digitMask_[level][k]) { levelEmpty = false; break; }
+        }
+        if (levelEmpty) levelMask_ &= ~(1u << level);
+
+        last_ = minKey_[b];
+        scratch_.swap(buckets_[b]);
+        LAB3_STATS_ONLY(++pulls; moved += scratch_.size();)
+        for (const auto& p : scratch_) place(p.first, p.second);
+        scratch_.clear();
+    }
+};
+
+//Kolejki z operacja decrease-key dla Dijkstry: wezly sa indeksowane numerem
+//wierzcholka, wiec kazdy wierzcholek jest w kolejce co najwyzej raz. Wspolny
+//interfejs: prepare(n), clear(), empty(), update(v, key) (wstawienie albo
+//zmniejszenie klucza) i popMin().
+
+//indeksowany kopiec d-arny, pos_[v] = pozycja v w tablicy kopca (-1 = poza kopcem)
+template <class Key, int D>
+class IndexedDaryHeap {
+public:
+    void prepare(int n) {
+        if (pos_.size() != static_cast<std::size_t>(n) + 1) pos_.assign(n + 1, -1);
+    }
+    void clear() {
+        for (const auto& e : heap_) pos_[e.second] = -1;
+        heap_.clear();
+    }
+    bool empty() const { return heap_.empty(); }
+
+    void update(int v, Key key) {
+        int i = pos_[v];
+        if (i < 0) {
+            i = static_cast<int>(heap_.size());
+            heap_.emplace_back(key, v);
+        } else {
+            assert(key <= heap_[i].first);
+            heap_[i].first = key;
+        }
+        siftUp(i);
+    }
+    std::pair<Key,int> popMin() {
+        std::pair<Key,int> top = heap_[0];
+        pos_[top.second] = -1;
+        std::pair<Key,int> last = heap_.back();
+        heap_.pop_back();
+        if (!heap_.empty()) {
+            heap_[0] = last;
+            siftDown(0);
+        }
+        return top;
+    }
+
+private:
+    std::vector<std::pair<Key,int>> heap_;
+    std::vector<int> pos_;
+
+    void siftUp(int i) {
+        std::pair<Key,int> e = heap_[i];
+        while (i > 0) {
+            int p = (i - 1) / D;
+            if (heap_[p].first <= e.first) break;
+            heap_[i] = heap_[p];
+            pos_[heap_[i].second] = i;
+            i = p;
+        }
+        heap_[i] = e;
+        pos_[e.second] = i;
+    }
+    void siftDown(int i) {
+        std::pair<Key,int> e = heap_[i];
+        const int n = static_cast<int>(heap_.size());
+        while (true) {
+            int first = i * D + 1;
+            if (first >= n) break;
+            int last = std::min(first + D, n);
+            int best = first;
+            for (int c = first + 1; c < last; ++c) {
+                if (heap_[c].first < heap_[best].first) best = c;
+            }
+            if (heap_[best].first >= e.first) break;
+            heap_[i] = heap_[best];
+            pos_[heap_[i].second] = i;
+            i = best;
+        }
+        heap_[i] = e;
+        pos_[e.second] = i;
+    }
+};
+
+//kopiec parujacy: dziecko-brat, prev_[v] to ojciec (dla najstarszego dziecka)
+//albo lewy brat; usuwanie minimum laczy dzieci dwuprzebiegowo
+template <class Key>
+class PairingHeap {
+public:
+    void prepare(int n) {
+        if (key_.size() != static_cast<std::size_t>(n) + 1) {
+            key_.assign(n + 1, Key());
+            child_.assign(n + 1, -1);
+            sibling_.assign(n + 1, -1);
+            prev_.assign(n + 1, -1);
+            in_.assign(n + 1, 0);
+        }
+    }
+    void clear() {
+        while (!empty()) popMin();
+    }
+    bool empty() const { return root_ < 0; }
+
+    void update(int v, Key key) {
+        if (!in_[v]) {
+            in_[v] = 1;
+            key_[v] = key;
+            child_[v] = sibling_[v] = prev_[v] = -1;
+            root_ = root_ < 0 ? v : meld(root_, v);
+            return;
+        }
+        assert(key <= key_[v]);
+        key_[v] = key;
+        if (v == root_) return;
+        //odciecie poddrzewa v i polaczenie go z korzeniem
+        int p = prev_[v];
+        if (child_[p] == v) child_[p] = sibling_[v];
+        else sibling_[p] = sibling_[v];
+        if (sibling_[v] >= 0) prev_[sibling_[v]] = p;
+        sibling_[v] = prev_[v] = -1;
+        root_ = meld(root_, v);
+    }
+    std::pair<Key,int> popMin() {
+        int r = root_;
+        in_[r] = 0;
+        root_ = mergePairs(child_[r]);
+        child_[r] = -1;
+        return { key_[r], r };
+    }
+
+private:
+    std::vector<Key> key_;
+    std::vector<int> child_;
+    std::vector<int> sibling_;
+    std::vector<int> prev_;
+    std::vector<char> in_;
+    std::vector<int> scratch_;
+    int root_ = -1;
+
+    //laczy dwa odlaczone drzewa, zwraca nowy korzen
+    int meld(int a, int b) {
+        if (key_[b] < key_[a]) std::swap(a, b);
+        sibling_[b] = child_[a];
+        if (child_[a] >= 0) prev_[child_[a]] = b;
+        prev_[b] = a;
+        child_[a] = b;
+        return a;
+    }
+    //pary od lewej, potem laczenie od prawej
+    int mergePairs(int c) {
+        if (c < 0) return -1;
+        scratch_.clear();
+        while (c >= 0) {
+            int a = c;
+            int b = sibling_[a];
+            sibling_[a] = prev_[a] = -1;
+            if (b < 0) {
+                scratch_.push_back(a);
+                break;
+            }
+            c = sibling_[b];
+            sibling_[b] = prev_[b] = -1;
+            scratch_.push_back(meld(a, b));
+        }
+        int r = scratch_.back();
+        for (int i = static_cast<int>(scratch_.size()) - 2; i >= 0; --i) r = meld(scratch_[i], r);
+        return r;
+    }
+};
+
+//kopiec Fibonacciego: listy cykliczne left_/right_, kaskadowe odcinanie przy
+//decrease-key i konsolidacja po stopniach przy usuwaniu minimum
+template <class Key>
+class FibonacciHeap {
+public:
+    void prepare(int n) {
+        if (key_.size() != static_cast<std::size_t>(n) + 1) {
+            key_.assign(n + 1, Key());
+            parent_.assign(n + 1, -1);
+            child_.assign(n + 1, -1);
+            left_.assign(n + 1, -1);
+            right_.assign(n + 1, -1);
+            degree_.assign(n + 1, 0);
+            mark_.assign(n + 1, 0);
+            in_.assign(n + 1, 0);
+        }
+    }
+    void clear() {
+        while (!empty()) popMin();
+    }
+    bool empty() const { return min_ < 0; }
+
+    void update(int v, Key key) {
+        if (!in_[v]) {
+            in_[v] = 1;
+            key_[v] = key;
+            parent_[v] = child_[v] = -1;
+            degree_[v] = 0;
+            mark_[v] = 0;
+            addRoot(v);
+            return;
+        }
+        assert(key <= key_[v]);
+        key_[v] = key;
+        int p = parent_[v];
+        if (p < 0) {
+            if (key < key_[min_]) min_ = v;
+            return;
+        }
+        if (!(key < key_[p])) return;
+        cut(v, p);
+        //kaskadowe odcinanie oznaczonych przodkow
+        for (int x = p; (p = parent_[x]) >= 0; x = p) {
+            if (!mark_[x]) {
+                mark_[x] = 1;
+                break;
+            }
+            cut(x, p);
+        }
+    }
+    std::pair<Key,int> popMin() {
+        int z = min_;
+        in_[z] = 0;
+        //dzieci z trafiaja na liste korzeni
+        int c = child_[z];
+        if (c >= 0) {
+            int x = c;
+            do {
+                parent_[x] = -1;
+                x = right_[x];
+            } while (x != c);
+            int zr = right_[z];
+            int cl = left_[c];
+            right_[z] = c;
+            left_[c] = z;
+            right_[cl] = zr;
+            left_[zr] = cl;
+            child_[z] = -1;
+        }
+        if (right_[z] == z) {
+            min_ = -1;
+        } else {
+            left_[right_[z]] = left_[z];
+            right_[left_[z]] = right_[z];
+            min_ = right_[z];
+            consolidate();
+        }
+        return { key_[z], z };
+    }
+
+private:
+    std::vector<Key> key_;
+    std::vector<int> parent_;
+    std::vector<int> child_;
+    std::vector<int> left_;
+    std::vector<int> right_;
+    std::vector<int> degree_;
+    std::vector<char> mark_;
+    std::vector<char> in_;
+    std::vector<int> roots_; //bufor konsolidacji
+    int byDegree_[64];
+    int min_ = -1;
+
+    //dopina v do listy korzeni obok minimum
+    void addRoot(int v) {
+        if (min_ < 0) {
+            left_[v] = right_[v] = v;
+            min_ = v;
+            return;
+        }
+        left_[v] = min_;
+        right_[v] = right_[min_];
+        left_[right_[min_]] = v;
+        right_[min_] = v;
+        if (key_[v] < key_[min_]) min_ = v;
+    }
+    //przenosi v z listy dzieci p na liste korzeni
+    void cut(int v, int p) {
+        if (right_[v] == v) {
+            child_[p] = -1;
+        } else {
+            left_[right_[v]] = left_[v];
+            right_[left_[v]] = right_[v];
+            if (child_[p] == v) child_[p] = right_[v];
+        }
+        --degree_[p];
+        parent_[v] = -1;
+        mark_[v] = 0;
+        addRoot(v);
+    }
+    //laczy korzenie o rownych stopniach, az wszystkie stopnie sa rozne
+    void consolidate() {
+        roots_.clear();
+        int x = min_;
+        do {
+            roots_.push_back(x);
+            x = right_[x];
+        } while (x != min_);
+
+        std::fill(std::begin(byDegree_), std::end(byDegree_), -1);
+        for (int w : roots_) {
+            x = w;
+            int d = degree_[x];
+            while (byDegree_[d] >= 0) {
+                int y = byDegree_[d];
+                if (key_[y] < key_[x]) std::swap(x, y);
+                //y zostaje dzieckiem x
+                parent_[y] = x;
+                mark_[y] = 0;
+                if (child_[x] < 0) {
+                    child_[x] = y;
+                    left_[y] = right_[y] = y;
+                } else {
+                    int c = child_[x];
+                    left_[y] = c;
+                    right_[y] = right_[c];
+                    left_[right_[c]] = y;
+                    right_[c] = y;
+                }
+                ++degree_[x];
+                byDegree_[d] = -1;
+                ++d;
+            }
+            byDegree_[d] = x;
+        }
+
+        min_ = -1;
+        for (int d = 0; d < 64; ++d) {
+            if (byDegree_[d] >= 0) addRoot(byDegree_[d]);
+        }
+    }
+};
+
+//bitmapa niepustych kubelkow z trzema poziomami: bit na kubelek, bit na slowo
+//kubelkow i bit na slowo poziomu srodkowego, wiec szukanie nastepnego
+//niepustego kubelka sprawdza co najwyzej kilka slow niezaleznie od odstepu
+class BucketBitmap {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    //ustawia liczbe kubelkow i zeruje wszystkie bity
+    void resize(std::size_t count) {
+        count_ = count;
+        bits_.assign((count + 63) / 64, 0);
+        mid_.assign((bits_.size() + 63) / 64, 0);
+        top_.assign((mid_.size() + 63) / 64, 0);
+    }
+    std::size_t size() const { return count_; }
+
+    void set(std::size_t i) {
+        bits_[i >> 6] |= 1ULL << (i & 63);
+        mid_[i >> 12] |= 1ULL << ((i >> 6) & 63);
+        top_[i >> 18] |= 1ULL << ((i >> 12) & 63);
+    }
+    void reset(std::size_t i) {
+        if (bits_[i >> 6] &= ~(1ULL << (i & 63))) return;
+        if (mid_[i >> 12] &= ~(1ULL << ((i >> 6) & 63))) return;
+        top_[i >> 18] &= ~(1ULL << ((i >> 12) & 63));
+    }
+
+    //najmniejszy niepusty kubelek o indeksie >= i (npos, gdy nie ma)
+    std::size_t findFrom(std::size_t i) const {
+        if (i >= count_) return npos;
+        std::size_t w = i >> 6;
+        std::uint64_t word = bits_[w] & (~0ULL << (i & 63));
+        if (word) return (w << 6) + __builtin_ctzll(word);
+
+        //nastepne niepuste slowo kubelkow w tym samym slowie poziomu srodkowego
+        ++w;
+        std::size_t mw = w >> 6;
+        if (mw >= mid_.size()) return npos;
+        std::uint64_t mword = mid_[mw] & (~0ULL << (w & 63));
+        if (!mword) {
+            //dalej szukamy przez poziom gorny
+            ++mw;
+            std::size_t tw = mw >> 6;
+            if (tw >= top_.size()) return npos;
+            std::uint64_t tword = top_[tw] & (~0ULL << (mw & 63));
+            while (!tword) {
+                if (++tw >= top_.size()) return npos;
+                tword = top_[tw];
+            }
+            mw = (tw << 6) + __builtin_ctzll(tword);
+            mword = mid_[mw];
+        }
+        w = (mw << 6) + __builtin_ctzll(mword);
+        return (w << 6) + __builtin_ctzll(bits_[w]);
+    }
+
+private:
+    std::size_t count_ = 0;
+    std::vector<std::uint64_t> bits_;
+    std::vector<std::uint64_t> mid_;
+    std::vector<std::uint64_t> top_;
+};
@@ -0,0 +1,79 @@
+//implementacje ISssp dla algorytmow z algo.h i deltastep.h
+#include "registry.h"
+#include <stdexcept>
+#include "algo.h"
+#include "deltastep.h"
+#include "parallel.h"
+
+namespace {
+
+class DijkstraSssp : public ISssp {
+public:
+    DijkstraSssp(const Graph& g, QueueKind queue) : g_(g), queue_(queue) {}
+    std::string name() const override { return "dijkstra"; }
+    void run(int s, QueryWorkspace& ws) override { dijkstra(g_, s, ws, queue_); }
+    void run(int s, QueryWorkspace32& ws) override { dijkstra(g_, s, ws, queue_); }
+
+private:
+    const Graph& g_;
+    QueueKind queue_;
+};
+
+class DialSssp : public ISssp {
+public:
+    DialSssp(const Graph& g, int C) : g_(g), C_(C) {}
+    std::string name() const override { return "dial"; }
+    void run(int s, QueryWorkspace& ws) override { dial(g_, s, ws, C_); }
+    void run(int s, QueryWorkspace32& ws) override { dial(g_, s, ws, C_); }
+
+private:
+    const Graph& g_;
+    int C_;
+};
+
+class RadixHeapSssp : public ISssp {
+public:
+    RadixHeapSssp(const Graph& g, RadixVariant variant) : g_(g), variant_(variant) {}
+    std::string name() const override { return "radixheap"; }
+    void run(int s, QueryWorkspace& ws) override { radixheap(g_, s, ws, variant_); }
+    void run(int s, QueryWorkspace32& ws) override { radixheap(g_, s, ws, variant_); }
+
+private:
+    const Graph& g_;
+    RadixVariant variant_;
+};
+
+class DeltaSteppingSssp : public ISssp {
+public:
+    DeltaSteppingSssp(const Graph& g, Distance delta, int maxCost, int threads)
+        : engine_(g, delta, maxCost, threads) {}
+    std::string name() const override { return "deltastepping"; }
+    void run(int s, QueryWorkspace& ws) override { engine_.run(s, ws); }
+    void run(int s, QueryWorkspace32& ws) override { engine_.run(s, ws); }
+    bool parallelQuery() const override { return true; }
+
+private:
+    DeltaStepping engine_;
+};
+
+}
+
+const std::vector<std::string>& ssspNames() {
+    static const std::vector<std::string> names = {"dijkstra", "dial", "radixheap", "deltastepping"};
+    return names;
+}
+
+std::unique_ptr<ISssp> makeSssp(const std::string& name, const Graph& g, const GraphMeta& meta,
+                                const ProgramOptions& options) {
+    if (name == "dijkstra") {
+        return std::make_unique<DijkstraSssp>(g, options.queue);
+    } else if (name == "dial") {
+        return std::make_unique<DialSssp>(g, meta.maxCost);
+    } else if (name == "radixheap") {
+        return std::make_unique<RadixHeapSssp>(g, options.radixVariant);
+    } else if (name == "deltastepping") {
+        Distance delta = options.delta > 0 ? options.delta : defaultDelta(meta);
+        return std::make_unique<DeltaSteppingSssp>(g, delta, meta.maxCost, resolveThreads(options.threads));
+    }
+    throw std::runtime_error("nieznany algorytm: " + name);
+}
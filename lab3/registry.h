@@ -0,0 +1,33 @@
+//rejestr algorytmow SSSP wybieranych po nazwie (-algo), wzorem aod::IMaxFlow z lab4
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include "common.h"
+#include "graph.h"
+#include "workspace.h"
+#include "cli.h"
+
+class ISssp {
+public:
+    virtual ~ISssp() = default;
+    virtual std::string name() const = 0;
+
+    //wynik w ws.dist (jak w algo.h); cele z ws.setTargets(...) sa respektowane
+    //przez algorytmy, ktore umieja konczyc wczesniej. Wersja z QueryWorkspace32
+    //liczy na odleglosciach 32-bitowych (tylko gdy fitsDistance32(meta)).
+    virtual void run(int s, QueryWorkspace& ws) = 0;
+    virtual void run(int s, QueryWorkspace32& ws) = 0;
+
+    //true, gdy algorytm sam dzieli jedno zapytanie na watki (-threads); obiekt ma
+    //wtedy wspolny stan, wiec zrodla sa liczone po kolei
+    virtual bool parallelQuery() const { return false; }
+};
+
+//nazwy w kolejnosci dla -algo all
+const std::vector<std::string>& ssspNames();
+
+//tworzy algorytm dla grafu g z parametrami z opcji (-queue, -radix, -delta, -threads);
+//nieznana nazwa konczy sie wyjatkiem
+std::unique_ptr<ISssp> makeSssp(const std::string& name, const Graph& g, const GraphMeta& meta,
+                                const ProgramOptions& options);
@@ -0,0 +1,214 @@
+//przenumerowanie wierzcholkow (BFS, RCM, DFS) i zapis permutacji
+#include "reorder.h"
+#include <fstream>
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
+#include <cstdint>
+
+namespace {
+
+constexpr char PERM_MAGIC[8] = {'A', 'O', 'D', 'P', 'E', 'R', 'M', 'S'};
+constexpr std::uint32_t PERM_VERSION = 1;
+
+struct PermFileHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::int32_t n;
+    std::int32_t m;
+    std::int32_t kind; //ReorderKind
+};
+
+//sasiedzi u w grafie nieskierowanym (luki g i grafu odwroconego rg)
+template <class F>
+void forNeighbors(const Graph& g, const Graph& rg, int u, F f) {
+    for (const auto& e : g[u]) f(e.to);
+    for (const auto& e : rg[u]) f(e.to);
+}
+
+//wierzcholek pseudo-peryferyjny (George, Liu): BFS z s, nowym startem zostaje
+//wierzcholek ostatniego poziomu o najmniejszym stopniu, dopoki rosnie ekscentrycznosc
+int pseudoPeripheral(const Graph& g, const Graph& rg, const std::vector<int>& degree, int s,
+                     std::vector<int>& mark, int& stamp, std::vector<int>& level, std::vector<int>& queue) {
+    int ecc = -1;
+    for (int sweep = 0; sweep < 8; ++sweep) {
+        ++stamp;
+        queue.clear();
+        queue.push_back(s);
+        mark[s] = stamp;
+        level[s] = 0;
+        for (std::size_t head = 0; head < queue.size(); ++head) {
+            int u = queue[head];
+            forNeighbors(g, rg, u, [&](int v) {
+                if (mark[v] != stamp) {
+                    mark[v] = stamp;
+                    level[v] = level[u] + 1;
+                    queue.push_back(v);
+                }
+            });
+        }
+        int last = level[queue.back()];
+        if (last <= ecc) break;
+        ecc = last;
+        int best = queue.back();
+        for (auto it = queue.rbegin(); it != queue.rend() && level[*it] == last; ++it) {
+            if (degree[*it] < degree[best]) best = *it;
+        }
+        s = best;
+    }
+    return s;
+}
+
+} // namespace
+
+void computeOrder(const Graph& g, ReorderKind kind, VertexOrder& order) {
+    const int n = g.n();
+    order.newId.clear();
+    order.oldId.clear();
+    if (kind == ReorderKind::None) return;
+
+    Graph rg;
+    reverseGraph(g, rg);
+    std::vector<int> degree(n+1, 0);
+    for (int u = 1; u <= n; ++u) degree[u] = g[u].size() + rg[u].size();
+
+    //kolejnosc prob startu kolejnych skladowych: RCM od najmniejszego stopnia
+    std::vector<int> starts(n);
+    for (int u = 1; u <= n; ++u) starts[u-1] = u;
+    if (kind == ReorderKind::RCM) {
+        std::stable_sort(starts.begin(), starts.end(), [&](int a, int b) { return degree[a] < degree[b]; });
+    }
+
+    std::vector<char> seen(n+1, 0);
+    std::vector<int> visit; //stare numery w kolejnosci odwiedzin
+    visit.reserve(n);
+    std::vector<int> mark, level, queue, stack, neighbors;
+    int stamp = 0;
+    if (kind == ReorderKind::RCM) {
+        mark.assign(n+1, 0);
+        level.assign(n+1, 0);
+    }
+
+    for (int s : starts) {
+        if (seen[s]) continue;
+        if (kind == ReorderKind::DFS) {
+            //preorder; sasiedzi wkladani od konca, zeby pierwszy byl odwiedzony pierwszy
+            stack.push_back(s);
+            while (!stack.empty()) {
+                int u = stack.back();
+                stack.pop_back();
+                if (seen[u]) continue;
+                seen[u] = 1;
+                visit.push_back(u);
+                neighbors.clear();
+                forNeighbors(g, rg, u, [&](int v) { if (!seen[v]) neighbors.push_back(v); });
+                stack.insert(stack.end(), neighbors.rbegin(), neighbors.rend());
+            }
+            continue;
+        }
+
+        if (kind == ReorderKind::RCM) {
+            s = pseudoPeripheral(g, rg, degree, s, mark, stamp, level, queue);
+        }
+        //BFS, kolejka to koncowka tablicy visit
+        std::size_t head = visit.size();
+        seen[s] = 1;
+        visit.push_back(s);
+        while (head < visit.size()) {
+            int u = visit[head++];
+            neighbors.clear();
+            forNeighbors(g, rg, u, [&](int v) {
+                if (!seen[v]) {
+                    seen[v] = 1;
+                    neighbors.push_back(v);
+                }
+            });
+            if (kind == ReorderKind::RCM) {
+                std::sort(neighbors.begin(), neighbors.end(), [&](int a, int b) {
+                    return degree[a] != degree[b] ? degree[a] < degree[b] : a < b;
+                });
+            }
+            visit.insert(visit.end(), neighbors.begin(), neighbors.end());
+        }
+    }
+    if (kind == ReorderKind::RCM) std::reverse(visit.begin(), visit.end());
+
+    order.newId.assign(n+1, 0);
+    order.oldId.assign(n+1, 0);
+    for (int i = 0; i < n; ++i) {
+        order.oldId[i+1] = visit[i];
+        order.newId[visit[i]] = i+1;
+    }
+}
+
+void permuteGraph(const Graph& g, const VertexOrder& order, Graph& out) {
+    const int n = g.n();
+    std::vector<int> offsets(n+2, 0);
+    for (int u = 1; u <= n; ++u) {
+        offsets[u+1] = offsets[u] + g[order.oldId[u]].size();
+    }
+
+    std::vector<Edge> arcs(static_cast<std::size_t>(g.arcCount()));
+    for (int u = 1; u <= n; ++u) {
+        int pos = offsets[u];
+        for (const auto& e : g[order.oldId[u]]) {
+            arcs[pos++] = {order.newId[e.to], e.w};
+        }
+        std::sort(arcs.begin() + offsets[u], arcs.begin() + offsets[u+1], [](const Edge& a, const Edge& b) {
+            return a.to != b.to ? a.to < b.to : a.w < b.w;
+        });
+    }
+    out.assign(std::move(offsets), std::move(arcs));
+}
+
+void saveOrder(const std::string& path, const VertexOrder& order, const GraphMeta& meta, ReorderKind kind) {
+    PermFileHeader h{};
+    std::memcpy(h.magic, PERM_MAGIC, sizeof(PERM_MAGIC));
+    h.version = PERM_VERSION;
+    h.n = meta.n;
+    h.m = meta.m;
+    h.kind = static_cast<std::int32_t>(kind);
+
+    const std::string tmpPath = path + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        throw std::runtime_error("Nie moge utworzyc pliku: " + tmpPath);
+    }
+    out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    out.write(reinterpret_cast<const char*>(order.oldId.data()), static_cast<std::streamsize>(order.oldId.size() * sizeof(int)));
+    out.close();
+    if (!out || std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        throw std::runtime_error("Nie moge zapisac pliku: " + path);
+    }
+}
+
+bool loadOrder(const std::string& path, const GraphMeta& meta, ReorderKind kind, VertexOrder& order) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return false;
+
+    PermFileHeader h;
+    in.read(reinterpret_cast<char*>(&h), sizeof(h));
+    if (!in || std::memcmp(h.magic, PERM_MAGIC, sizeof(PERM_MAGIC)) != 0 || h.version != PERM_VERSION
+        || h.n != meta.n || h.m != meta.m || h.kind != static_cast<std::int32_t>(kind)) {
+        return false;
+    }
+
+    order.oldId.resize(static_cast<std::size_t>(meta.n) + 1);
+    in.read(reinterpret_cast<char*>(order.oldId.data()), static_cast<std::streamsize>(order.oldId.size() * sizeof(int)));
+    if (!in) return false;
+
+    //odtworzenie odwrotnej permutacji, z kontrola ze plik zawiera permutacje
+    order.newId.assign(order.oldId.size(), 0);
+    for (int u = 1; u <= meta.n; ++u) {
+        int v = order.oldId[u];
+        if (v < 1 || v > meta.n || order.newId[v] != 0) {
+            order.newId.clear();
+            order.oldId.clear();
+            return false;
+        }
+        order.newId[v] = u;
+    }
+    return true;
+}
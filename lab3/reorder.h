@@ -0,0 +1,34 @@
+//przenumerowanie wierzcholkow dla lepszej lokalnosci dist[v] i g[v]
+#pragma once
+#include <vector>
+#include <string>
+#include "common.h"
+#include "graph.h"
+#include "cli.h"
+
+//permutacja wierzcholkow 1..n (indeks 0 nieuzywany); pusta = brak przenumerowania.
+//Numery spoza [1, n] przechodza bez zmian, zeby dalej dawaly brak sciezki.
+struct VertexOrder {
+    std::vector<int> newId; //newId[stary] = nowy
+    std::vector<int> oldId; //oldId[nowy] = stary
+
+    bool empty() const { return newId.empty(); }
+    int n() const { return empty() ? 0 : static_cast<int>(newId.size()) - 1; }
+    int toNew(int v) const { return (v >= 1 && v <= n()) ? newId[v] : v; }
+    int toOld(int v) const { return (v >= 1 && v <= n()) ? oldId[v] : v; }
+};
+
+//kolejnosc odwiedzin przeszukiwania grafu traktowanego jako nieskierowany
+//(luki wychodzace i wchodzace); kazda skladowa jest przechodzona osobno.
+//BFS i DFS startuja z wierzcholka o najmniejszym numerze, RCM (odwrocony
+//Cuthill-McKee) z wierzcholka pseudo-peryferyjnego i odwiedza sasiadow
+//w kolejnosci rosnacego stopnia.
+void computeOrder(const Graph& g, ReorderKind kind, VertexOrder& order);
+
+//graf z wierzcholkami w nowej numeracji; luki kazdego wierzcholka sa
+//posortowane po nowym numerze celu
+void permuteGraph(const Graph& g, const VertexOrder& order, Graph& out);
+
+void saveOrder(const std::string& path, const VertexOrder& order, const GraphMeta& meta, ReorderKind kind);
+//false, gdy pliku nie ma albo nie pasuje do grafu lub rodzaju przenumerowania
+bool loadOrder(const std::string& path, const GraphMeta& meta, ReorderKind kind, VertexOrder& order);
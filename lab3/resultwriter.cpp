@@ -0,0 +1,180 @@
+//implementacja zapisu wynikow
+#include "resultwriter.h"
+#include "io.h"
+#include <charconv>
+#include <algorithm>
+#include <sstream>
+#include <cstring>
+#include <cstdint>
+#include <cstddef>
+#include <stdexcept>
+
+namespace {
+
+constexpr char RES_MAGIC[8] = {'A', 'O', 'D', 'P', '2', 'P', 'R', 'S'};
+constexpr std::uint32_t RES_VERSION = 1;
+
+struct P2PResultHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::int32_t n;
+    std::int32_t m;
+    std::int32_t minCost;
+    std::int32_t maxCost;
+    std::uint32_t reserved;
+};
+
+struct P2PResultRecord {
+    std::int32_t s;
+    std::int32_t t;
+    std::int64_t d;
+};
+
+//miejsce na jedna liczbe (long long ma co najwyzej 20 znakow) i separator
+constexpr std::ptrdiff_t FIELD = 21;
+constexpr std::size_t MAX_LINE = 2 + 3 * FIELD + 1;
+
+} // namespace
+
+ResultWriter::ResultWriter(const std::string& path, ResultFormat format, bool background, std::size_t bufferSize)
+    : format_(format), capacity_(std::max<std::size_t>(bufferSize, 4096)), background_(background) {
+    file_ = std::fopen(path.c_str(), "wb");
+    if (!file_) {
+        throw std::runtime_error("Nie mozna otworzyc pliku wyjsciowego");
+    }
+    std::setvbuf(file_, nullptr, _IONBF, 0); //buforujemy sami
+    buffer_.reserve(capacity_);
+    if (background_) {
+        pending_.reserve(capacity_);
+        thread_ = std::thread(&ResultWriter::writerLoop, this);
+    }
+}
+
+ResultWriter::~ResultWriter() {
+    try {
+        close();
+    } catch (...) {
+        //blad zapisu zglaszany jest tylko przez jawne close()
+    }
+}
+
+void ResultWriter::writeHeader(const std::string& graphFile, const std::string& p2pFile, const GraphMeta& meta) {
+    if (format_ == ResultFormat::Text) {
+        std::ostringstream header;
+        saveP2P(header, graphFile, p2pFile, meta);
+        const std::string text = header.str();
+        append(text.data(), text.size());
+    } else {
+        P2PResultHeader h{};
+        std::memcpy(h.magic, RES_MAGIC, sizeof(RES_MAGIC));
+        h.version = RES_VERSION;
+        h.n = meta.n;
+        h.m = meta.m;
+        h.minCost = meta.minCost;
+        h.maxCost = meta.maxCost;
+        append(reinterpret_cast<const char*>(&h), sizeof(h));
+    }
+}
+
+void ResultWriter::write(int s, int t, Distance d) {
+    if (format_ == ResultFormat::Binary) {
+        P2PResultRecord r{s, t, d >= INF / 2 ? -1 : static_cast<std::int64_t>(d)};
+        append(reinterpret_cast<const char*>(&r), sizeof(r));
+        return;
+    }
+
+    char line[MAX_LINE];
+    char* p = line;
+    const bool unreachable = d >= INF / 2;
+    *p++ = unreachable ? 'u' : 'd';
+    *p++ = ' ';
+    p = std::to_chars(p, p + FIELD - 1, s).ptr;
+    *p++ = ' ';
+    p = std::to_chars(p, p + FIELD - 1, t).ptr;
+    *p++ = ' ';
+    if (unreachable) {
+        std::memcpy(p, "INF", 3);
+        p += 3;
+    } else {
+        p = std::to_chars(p, p + FIELD - 1, d).ptr;
+    }
+    *p++ = '\n';
+    append(line, static_cast<std::size_t>(p - line));
+}
+
+void ResultWriter::writePath(int s, int t, const int* path, std::size_t k) {
+    if (format_ != ResultFormat::Text) {
+        throw std::runtime_error("sciezki sa zapisywane tylko w formacie tekstowym");
+    }
+    char field[FIELD + 1];
+    auto put = [&](long long value) {
+        char* p = field;
+        *p++ = ' ';
+        p = std::to_chars(p, p + FIELD - 1, value).ptr;
+        append(field, static_cast<std::size_t>(p - field));
+    };
+    append("p", 1);
+    put(s);
+    put(t);
+    put(static_cast<long long>(k));
+    for (std::size_t i = 0; i < k; ++i) put(path[i]);
+    append("\n", 1);
+}
+
+void ResultWriter::close() {
+    if (!file_) return;
+    flushBuffer();
+    if (background_) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        cv_.notify_all();
+        thread_.join();
+    }
+    bool closeFailed = std::fclose(file_) != 0;
+    file_ = nullptr;
+    if (failed_ || closeFailed) {
+        throw std::runtime_error("Blad zapisu pliku wynikowego");
+    }
+}
+
+void ResultWriter::append(const char* data, std::size_t size) {
+    if (buffer_.size() + size > capacity_) flushBuffer();
+    buffer_.insert(buffer_.end(), data, data + size);
+}
+
+void ResultWriter::flushBuffer() {
+    if (buffer_.empty()) return;
+    if (!background_) {
+        writeOut(buffer_);
+        buffer_.clear();
+        return;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    cv_.wait(lock, [this] { return !hasPending_; }); //poprzedni bufor musi byc juz zapisany
+    pending_.swap(buffer_);
+    hasPending_ = true;
+    lock.unlock();
+    cv_.notify_all();
+    buffer_.clear();
+    buffer_.reserve(capacity_);
+}
+
+void ResultWriter::writeOut(const std::vector<char>& data) {
+    if (std::fwrite(data.data(), 1, data.size(), file_) != data.size()) failed_ = true;
+}
+
+void ResultWriter::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this] { return hasPending_ || stop_; });
+        if (!hasPending_) break; //stop_ i nic do zapisu
+        lock.unlock();
+        writeOut(pending_);
+        pending_.clear();
+        lock.lock();
+        hasPending_ = false;
+        cv_.notify_all();
+    }
+}
@@ -0,0 +1,54 @@
+//zapis wynikow zapytan p2p (.res) przez duzy bufor w pamieci
+#pragma once
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include "common.h"
+#include "graph.h"
+#include "cli.h"
+
+//Liczby sa zamieniane na tekst przez std::to_chars bez strumieni, a pelny bufor jest
+//przekazywany watkowi zapisujacemu, ktory pisze go na dysk, gdy obliczenia trwaja
+//dalej w drugim buforze. Format tekstowy jest bajt w bajt taki jak saveP2P + linie
+//"d s t dist" / "u s t INF". Format binarny: naglowek P2PResultHeader, potem rekordy
+//{int32 s, int32 t, int64 dist} (dist = -1 gdy brak sciezki).
+class ResultWriter {
+public:
+    ResultWriter(const std::string& path, ResultFormat format, bool background = true,
+                 std::size_t bufferSize = 1 << 20);
+    ~ResultWriter();
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+
+    //naglowek pliku (dla formatu tekstowego ten sam co saveP2P)
+    void writeHeader(const std::string& graphFile, const std::string& p2pFile, const GraphMeta& meta);
+    void write(int s, int t, Distance d);
+    //linia "p s t k v1 ... vk" z wierzcholkami sciezki (k = 0, gdy jej nie ma);
+    //tylko format tekstowy
+    void writePath(int s, int t, const int* path, std::size_t k);
+    //dopisuje reszte bufora i zamyka plik; rzuca wyjatek, gdy zapis sie nie udal
+    void close();
+
+private:
+    void append(const char* data, std::size_t size);
+    void flushBuffer(); //przekazuje biezacy bufor do zapisu
+    void writeOut(const std::vector<char>& data);
+    void writerLoop();
+
+    std::FILE* file_ = nullptr;
+    ResultFormat format_;
+    std::size_t capacity_;
+    std::vector<char> buffer_; //wypelniany przez watek obliczen
+
+    bool background_;
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::vector<char> pending_; //bufor czekajacy na zapis w tle
+    bool hasPending_ = false;
+    bool stop_ = false;
+    bool failed_ = false;
+};
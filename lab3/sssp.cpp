@@ -0,0 +1,6 @@
+//main wspolny dla wszystkich algorytmow: sssp -algo dijkstra,dial,radixheap ...
+#include "driver.h"
+
+int main(int argc, char* argv[]){
+    return runDriver(argc, argv, "sssp", "dijkstra");
+}
@@ -0,0 +1,97 @@
+//implementacja statystyk zapytan
+#include "stats.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+void QueryStats::add(const QueryStats& other) {
+    pushes += other.pushes;
+    pops += other.pops;
+    stalePops += other.stalePops;
+    relaxations += other.relaxations;
+    bucketScans += other.bucketScans;
+    bucketsSkipped += other.bucketsSkipped;
+    radixPulls += other.radixPulls;
+    radixMoved += other.radixMoved;
+}
+
+namespace {
+
+double percentile(const std::vector<double>& sorted, double p) {
+    std::size_t rank = static_cast<std::size_t>(std::ceil(p * static_cast<double>(sorted.size())));
+    return sorted[std::max<std::size_t>(rank, 1) - 1];
+}
+
+} // namespace
+
+LatencySummary summarizeLatencies(std::vector<double> samples) {
+    LatencySummary s;
+    s.count = samples.size();
+    if (samples.empty()) return s;
+
+    std::sort(samples.begin(), samples.end());
+    double sum = 0.0;
+    for (double x : samples) sum += x;
+    s.mean = sum / static_cast<double>(samples.size());
+    s.p50 = percentile(samples, 0.50);
+    s.p90 = percentile(samples, 0.90);
+    s.p99 = percentile(samples, 0.99);
+    s.max = samples.back();
+    return s;
+}
+
+void saveStatsComments(std::ostream& out, const LatencySummary& latency, const QueryStats& counters) {
+    out << "c\n";
+    out << "c Czasy zapytan [ms]: p50 " << latency.p50 << ", p90 " << latency.p90
+        << ", p99 " << latency.p99 << ", max " << latency.max << "\n";
+    out << "c Kolejka: wstawienia " << counters.pushes << ", zdjecia " << counters.pops
+        << " (nieaktualne " << counters.stalePops << "), relaksacje " << counters.relaxations << "\n";
+    out << "c Kubelki: szukania " << counters.bucketScans << ", przeskoczone " << counters.bucketsSkipped
+        << "; radix pull(): " << counters.radixPulls << ", przeniesione " << counters.radixMoved << "\n";
+}
+
+void saveStatsJson(const std::string& path, const std::string& algoName, const std::string& mode,
+                   const std::vector<double>& samples, const QueryStats& counters) {
+    std::ofstream out(path);
+    if (!out) {
+        throw std::runtime_error("Nie moge utworzyc pliku statystyk: " + path);
+    }
+    LatencySummary latency = summarizeLatencies(samples);
+
+    //histogram: kubelek k liczy zapytania z czasem <= 2^k ms
+    std::vector<std::pair<int, std::size_t>> histogram;
+    for (double x : samples) {
+        int k = x > 0.0 ? static_cast<int>(std::ceil(std::log2(x))) : -20;
+        k = std::max(k, -20);
+        auto it = std::find_if(histogram.begin(), histogram.end(), [k](const auto& b) { return b.first == k; });
+        if (it == histogram.end()) histogram.push_back({k, 1});
+        else ++it->second;
+    }
+    std::sort(histogram.begin(), histogram.end());
+
+    out << "{\n";
+    out << "  \"algorithm\": \"" << algoName << "\",\n";
+    out << "  \"mode\": \"" << mode << "\",\n";
+    out << "  \"queries\": " << latency.count << ",\n";
+    out << "  \"latency_ms\": {\"mean\": " << latency.mean << ", \"p50\": " << latency.p50
+        << ", \"p90\": " << latency.p90 << ", \"p99\": " << latency.p99 << ", \"max\": " << latency.max << "},\n";
+    out << "  \"histogram_ms\": [";
+    for (std::size_t i = 0; i < histogram.size(); ++i) {
+        out << (i ? ", " : "") << "{\"le\": " << std::ldexp(1.0, histogram[i].first)
+            << ", \"count\": " << histogram[i].second << "}";
+    }
+    out << "],\n";
+    if (STATS_ENABLED) {
+        out << "  \"counters\": {\"pushes\": " << counters.pushes << ", \"pops\": " << counters.pops
+            << ", \"stale_pops\": " << counters.stalePops << ", \"relaxations\": " << counters.relaxations
+            << ", \"bucket_scans\": " << counters.bucketScans << ", \"buckets_skipped\": " << counters.bucketsSkipped
+            << ", \"radix_pulls\": " << counters.radixPulls << ", \"radix_moved\": " << counters.radixMoved << "}\n";
+    } else {
+        out << "  \"counters\": null\n";
+    }
+    out << "}\n";
+    if (!out) {
+        throw std::runtime_error("Nie moge zapisac pliku statystyk: " + path);
+    }
+}
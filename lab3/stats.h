@@ -0,0 +1,49 @@
+//opcjonalne statystyki zapytan: liczniki operacji kolejek i rozklad czasow
+#pragma once
+#include <string>
+#include <vector>
+#include <ostream>
+
+//Liczniki sa wkompilowane tylko z -DLAB3_STATS (make STATS=1); bez tego
+//LAB3_STATS_ONLY(...) znika, wiec algorytmy nie wykonuja zadnej dodatkowej pracy.
+#ifdef LAB3_STATS
+#define LAB3_STATS_ONLY(...) __VA_ARGS__
+constexpr bool STATS_ENABLED = true;
+#else
+#define LAB3_STATS_ONLY(...)
+constexpr bool STATS_ENABLED = false;
+#endif
+
+//liczniki sumowane po wszystkich zapytaniach workspace'u
+struct QueryStats {
+    long long pushes = 0; //wstawienia do kolejki (w kolejkach z decrease-key takze zmniejszenia klucza)
+    long long pops = 0; //zdjecia z kolejki
+    long long stalePops = 0; //zdjete nieaktualne wpisy
+    long long relaxations = 0; //udane relaksacje (odleglosc zmniejszona)
+    long long bucketScans = 0; //szukania nastepnego niepustego kubelka (Dial)
+    long long bucketsSkipped = 0; //kubelki przeskoczone przy tych szukaniach
+    long long radixPulls = 0; //wywolania pull() w radix heap
+    long long radixMoved = 0; //elementy przeniesione przez pull()
+
+    void add(const QueryStats& other);
+};
+
+//rozklad czasow pojedynczych zapytan [ms], percentyle metoda najblizszej rangi
+struct LatencySummary {
+    std::size_t count = 0;
+    double mean = 0.0;
+    double p50 = 0.0;
+    double p90 = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+};
+
+LatencySummary summarizeLatencies(std::vector<double> samples);
+
+//dodatkowe linie c w pliku wynikowym ss (tylko przy LAB3_STATS)
+void saveStatsComments(std::ostream& out, const LatencySummary& latency, const QueryStats& counters);
+
+//plik JSON obok wynikow: czasy, histogram (kubelki potegi 2 w ms) i liczniki
+//(null, gdy program zbudowano bez LAB3_STATS)
+void saveStatsJson(const std::string& path, const std::string& algoName, const std::string& mode,
+                   const std::vector<double>& samples, const QueryStats& counters);
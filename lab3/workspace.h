@@ -0,0 +1,124 @@
+//stan zapytania wielokrotnego uzytku: tablica odleglosci i kolejki algorytmow
+#pragma once
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "common.h"
+#include "queues.h"
+#include "stats.h"
+
+//Tablica dist ma INF wszedzie poza wierzcholkami z listy touched, wiec reset
+//przed kolejnym zapytaniem kosztuje tyle, ile poprzednie zapytanie odwiedzilo,
+//a nie O(n). Kolejki zachowuja pamiec miedzy zapytaniami. Dist to typ odleglosci
+//(Distance albo Distance32, patrz common.h); nieosiagalne maja infinityOf<Dist>().
+template <class Dist>
+struct BasicQueryWorkspace {
+    using DistanceType = Dist;
+    using P = std::pair<Dist, int>; //para (odleglosc, wierzcholek)
+    static constexpr Dist UNREACHED = infinityOf<Dist>();
+
+    std::vector<Dist> dist; //wynik ostatniego zapytania (UNREACHED = nieosiagalny)
+    std::vector<int> touched; //wierzcholki z dist != UNREACHED
+
+    //drzewo najkrotszych sciezek, tylko gdy trackParents: parent[v] to poprzednik v
+    //(0 dla zrodla), wazny dla wierzcholkow z touched. Algorytmy sprawdzaja flage raz
+    //na zapytanie i wybieraja wersje szablonu, wiec bez sledzenia nic nie kosztuje.
+    bool trackParents = false;
+    std::vector<int> parent;
+
+    std::vector<P> heap; //kopiec binarny Dijkstry (std::push_heap / std::pop_heap)
+    //kolejki z decrease-key (-queue dary4|pairing|fibonacci), pamiec tylko po uzyciu
+    IndexedDaryHeap<Dist, 4> dary;
+    PairingHeap<Dist> pairing;
+    FibonacciHeap<Dist> fibonacci;
+    //kubelki Diala (okno cykliczne): glowy list i dwukierunkowe listy wierzcholkow,
+    //dialPrev[v] == DIAL_UNLISTED gdy v nie lezy w zadnym kubelku
+    static constexpr int DIAL_UNLISTED = -2;
+    std::vector<int> dialHead;
+    std::vector<int> dialNext;
+    std::vector<int> dialPrev;
+    BucketBitmap dialBits; //niepuste kubelki Diala
+    std::vector<P> dialOverflow; //kopiec wpisow poza oknem kubelkow
+    RadixHeap<Dist> radix; //pierwotna wersja (-radix legacy)
+    PooledRadixHeap<Dist> radixPooled;
+    TwoLevelRadixHeap<Dist> radixTwoLevel;
+
+    //cele zapytania: algorytmy koncza, gdy wszystkie sa ustalone (brak celow = pelne drzewo);
+    //odleglosci pozostalych wierzcholkow sa wtedy tylko oszacowaniami z gory
+    std::vector<char> isTarget;
+    std::vector<int> targets; //rozne cele (isTarget[t] == 1)
+    std::size_t targetsLeft = 0; //cele jeszcze nieustalone w biezacym zapytaniu
+
+    QueryStats stats; //sumowane po wszystkich zapytaniach (tylko z LAB3_STATS)
+
+    //liczniki ostatniego zapytania
+    long long settled = 0; //ustalone wierzcholki
+    long long relaxed = 0; //przejrzane luki
+
+    //przygotowuje workspace do zapytania na grafie o n wierzcholkach
+    void reset(int n) {
+        if (static_cast<int>(dist.size()) != n + 1) {
+            dist.assign(n + 1, UNREACHED);
+        } else {
+            for (int v : touched) dist[v] = UNREACHED;
+        }
+        touched.clear();
+        if (trackParents && static_cast<int>(parent.size()) != n + 1) parent.assign(n + 1, 0);
+        targetsLeft = targets.size();
+        settled = 0;
+        relaxed = 0;
+    }
+
+    //ustawia cele kolejnych zapytan; wierzcholki spoza [1, n] sa pomijane
+    template <class Targets>
+    void setTargets(const Targets& ts, int n) {
+        clearTargets();
+        if (static_cast<int>(isTarget.size()) != n + 1) isTarget.assign(n + 1, 0);
+        for (int t : ts) {
+            if (t >= 1 && t <= n && !isTarget[t]) {
+                isTarget[t] = 1;
+                targets.push_back(t);
+            }
+        }
+    }
+    void clearTargets() {
+        for (int t : targets) isTarget[t] = 0;
+        targets.clear();
+    }
+
+    //zaznacza ustalenie u o `degree` lukach wychodzacych; true, gdy u byl ostatnim
+    //nieustalonym celem i wyszukiwanie moze sie skonczyc
+    bool settle(int u, int degree) {
+        ++settled;
+        if (targetsLeft && isTarget[u] && --targetsLeft == 0) return true;
+        relaxed += degree;
+        return false;
+    }
+
+    //ustawia odleglosc, zapamietujac wierzcholek przy pierwszym dotknieciu
+    void setDist(int v, Dist d) {
+        if (dist[v] == UNREACHED) touched.push_back(v);
+        dist[v] = d;
+    }
+
+    //setDist z zapisem poprzednika u, gdy Parents (zrodlo dostaje u = 0)
+    template <bool Parents>
+    void setDistFrom(int v, Dist d, int u) {
+        setDist(v, d);
+        if constexpr (Parents) parent[v] = u;
+    }
+
+    //sciezka do t z ostatniego zapytania (od zrodla do t wlacznie); false, gdy t
+    //nie zostal osiagniety. Przy celach z setTargets sciezki do ustalonych celow
+    //sa juz ostateczne.
+    bool pathTo(int t, std::vector<int>& path) const {
+        path.clear();
+        if (t < 1 || t >= static_cast<int>(dist.size()) || dist[t] == UNREACHED) return false;
+        for (int v = t; v != 0; v = parent[v]) path.push_back(v);
+        std::reverse(path.begin(), path.end());
+        return true;
+    }
+};
+
+using QueryWorkspace = BasicQueryWorkspace<Distance>;
+using QueryWorkspace32 = BasicQueryWorkspace<Distance32>;
@@ -2,6 +2,10 @@
 #include "aod/flow/maxflowBase.hpp"
 
 namespace aod {
+    // Dinic z iteracyjnym przepływem blokującym (jawny stos łuków, wiele ścieżek
+    // na jedno przejście). FlowStats: bfs_runs = fazy, dfs_calls = wywołania
+    // dawnego rekurencyjnego DFS-a (każda ścieżka od s), augmentations = łuki na
+    // ścieżkach powiększających.
     class Dinic : public IMaxFlow {
         public:
             std::string name() const override { return "dinic"; }
@@ -0,0 +1,25 @@
+#pragma once
+#include "aod/flow/maxflowBase.hpp"
+#include "aod/graph/bipartite.hpp"
+#include <vector>
+
+namespace aod {
+    // Hopcroft–Karp bezpośrednio na listach V1 -> V2 (bez sieci S/T).
+    // Faza: BFS od wolnych wierzchołków V1 wyznacza warstwy do najbliższych
+    // wolnych V2, potem iteracyjny DFS po warstwach znajduje maksymalny zbiór
+    // rozłącznych najkrótszych ścieżek powiększających (O(sqrt(V) * E)).
+    // FlowStats: bfs_runs = fazy, dfs_calls = wejścia w wierzchołki V1,
+    // augmentations = ścieżki powiększające (bez wstępnego skojarzenia zachłannego).
+    class HopcroftKarp {
+        public:
+            std::string name() const { return "hopcroft-karp"; }
+            long long run(const BipartiteGraph& g, FlowStats& st);
+
+            // po run(): para u z V1 albo -1
+            const std::vector<int>& mate_left() const { return mateL_; }
+
+        private:
+            std::vector<int> mateL_;
+            std::vector<int> mateR_;
+    };
+}
@@ -8,6 +8,9 @@ namespace aod {
         std::int64_t augmentations = 0; //liczba sciezek powiekszajacych przeplyw
         std::int64_t bfs_runs = 0;
         std::int64_t dfs_calls = 0; //Dinic
+        std::int64_t pushes = 0; //push-relabel
+        std::int64_t relabels = 0;
+        std::int64_t global_updates = 0; //globalne przeetykietowania (BFS)
     };
 
     class FlowNetwork; 
@@ -0,0 +1,14 @@
+#pragma once
+#include "aod/flow/maxflowBase.hpp"
+
+namespace aod {
+    // Push-relabel z wyborem najwyższej etykiety, heurystyką luki
+    // i okresowym globalnym przeetykietowaniem (BFS od t i od s).
+    // Nadmiar, który nie dojdzie do t, wraca do s, więc po run()
+    // sieć zawiera poprawny przepływ (jak po EK/Dinicu).
+    class PushRelabel : public IMaxFlow {
+        public:
+            std::string name() const override { return "push-relabel"; }
+            long long run(FlowNetwork& net, int s, int t, FlowStats& st) override;
+    };
+}
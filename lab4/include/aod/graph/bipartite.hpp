@@ -0,0 +1,15 @@
+#pragma once
+#include <vector>
+
+namespace aod {
+
+    // Graf dwudzielny V1 -> V2 w CSR, bez źródła, ujścia i łuków odwrotnych:
+    // sąsiedzi u z V1 (etykiety 0..right-1) to adj[offset[u] .. offset[u+1]).
+    struct BipartiteGraph {
+        int left = 0;  // |V1|
+        int right = 0; // |V2|
+        std::vector<int> offset;
+        std::vector<int> adj;
+    };
+
+}
@@ -1,31 +1,62 @@
 #pragma once
 #include <vector>
 #include <cstdint>
+#include <cstddef>
 
 namespace aod {
 
-    struct Edge {
-        int to;
-        int rev; //index krawędzi odwrotnej w adj[to]
-        long long cap; //residual capacity
-        long long orig = 0; //oryginalna pojemność
-    };
-
+    // Sieć residualna w dwóch fazach:
+    //  1) budowa: add_edge() dopisuje krawędź (u, v, cap) do listy,
+    //  2) freeze(): topologia zamienia się w CSR (łuki wierzchołka u to [begin(u), end(u)))
+    //     i od tej chwili jest stała; zmieniają się tylko pojemności residualne.
+    // Każda krawędź daje parę łuków (forward i reverse) wskazujących na siebie przez rev().
+    // Łuki wierzchołka są w kolejności dodawania, więc łuk nr idx z listy u
+    // (jak dawniej adj()[u][idx]) to arc(u, idx).
     class FlowNetwork {
         public:
-            explicit FlowNetwork(int n = 0) : adj_(n) {}
+            explicit FlowNetwork(int n = 0) : n_(n), deg_(n, 0) {}
+
+            int n() const { return n_; }
+            void reset(int n);
 
-            int n() const { return (int)adj_.size(); }
-            void reset(int n) { adj_.assign(n, {}); }
+            // zwraca indeks łuku forward na liście u (tylko przed freeze())
+            int add_edge(int u, int v, long long cap);
+            void reserve_edges(std::size_t m) { pending_.reserve(m); }
 
-            void add_edge(int u, int v, long long cap);
+            void freeze();
+            bool frozen() const { return !offset_.empty(); }
+            // przywraca pojemności sprzed uruchomienia algorytmu (bez realokacji)
+            void reset_flow() { cap_ = orig_; }
 
-            std::vector<std::vector<Edge>>& adj() { return adj_; }
-            const std::vector<std::vector<Edge>>& adj() const { return adj_; }
+            // ===== CSR (po freeze) =====
+            int begin(int u) const { return offset_[u]; }
+            int end(int u) const { return offset_[u + 1]; }
+            int arc_count() const { return (int)to_.size(); }
+            int arc(int u, int idx) const { return offset_[u] + idx; }
+
+            int to(int a) const { return to_[a]; }
+            int rev(int a) const { return rev_[a]; } // łuk odwrotny
+            long long& cap(int a) { return cap_[a]; } // pojemność residualna
+            long long cap(int a) const { return cap_[a]; }
+            long long orig(int a) const { return orig_[a]; } // oryginalna pojemność (0 dla reverse)
+            long long flow(int a) const { return orig_[a] - cap_[a]; }
 
         private:
-            std::vector<std::vector<Edge>> adj_;
+            struct PendingEdge {
+                int u;
+                int v;
+                long long cap;
+            };
+
+            int n_;
+            std::vector<int> deg_; // liczba łuków (z reverse) każdego wierzchołka
+            std::vector<PendingEdge> pending_; // krawędzie przed freeze()
+
+            std::vector<int> offset_; // n + 1 początków list łuków
+            std::vector<int> to_;
+            std::vector<int> rev_;
+            std::vector<long long> cap_; // SoA: pojemności osobno od topologii
+            std::vector<long long> orig_;
     };
 
 }
-
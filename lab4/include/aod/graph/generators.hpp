@@ -1,5 +1,6 @@
 #pragma once
 #include "aod/graph/flowNetwork.hpp"
+#include "aod/graph/bipartite.hpp"
 #include <vector>
 #include <utility>
 #include <cstdint>
@@ -7,10 +8,10 @@
 namespace aod {
 
 
-    using EdgeRef = std::pair<int,int>;//lista (u, idx) wskazującą na forward-edge w net.adj()[u][idx]
+    using EdgeRef = std::pair<int,int>;//lista (u, idx) wskazującą na forward-edge net.arc(u, idx)
 
     struct GeneratedFlowInstance {
-        FlowNetwork net;
+        FlowNetwork net; // już po freeze()
         int s = 0;
         int t = 0;
         std::vector<EdgeRef> forward_edges; //do printFlow / printMatching
@@ -19,5 +20,10 @@ namespace aod {
     GeneratedFlowInstance generate_hypercube(int k, std::uint64_t seed);
     GeneratedFlowInstance generate_bipartite_matching(int k, int degree, std::uint64_t seed);
 
+    // sam graf dwudzielny |V1|=|V2|=2^k (k <= 20); generate_bipartite_matching
+    // z tym samym seedem daje sieć S/T zbudowaną z dokładnie tych krawędzi
+    BipartiteGraph generate_bipartite(int k, int degree, std::uint64_t seed);
+    GeneratedFlowInstance bipartite_flow_network(const BipartiteGraph& g);
+
 } // namespace aod
 
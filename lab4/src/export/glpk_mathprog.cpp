@@ -11,7 +11,7 @@ namespace aod {
         if (!out) throw std::runtime_error("Cannot open file for writing: " + path);
 
         const int n = net.n();
-        const auto& g = net.adj();
+        if (!net.frozen()) throw std::runtime_error("export_maxflow_mathprog: network must be frozen");
 
         // ===== Model section =====
         out << "set V;\n";
@@ -46,8 +46,8 @@ namespace aod {
 
         out << "set A :=\n";
         for (int u = 0; u < n; ++u) {
-            for (const auto& e : g[u]) {
-                if (e.orig > 0) out << "  (" << u << "," << e.to << ")\n";
+            for (int a = net.begin(u); a < net.end(u); ++a) {
+                if (net.orig(a) > 0) out << "  (" << u << "," << net.to(a) << ")\n";
             }
         }
         out << ";\n\n";
@@ -55,8 +55,8 @@ namespace aod {
         // Bezpieczny format: u v cap
         out << "param cap :=\n";
         for (int u = 0; u < n; ++u) {
-            for (const auto& e : g[u]) {
-                if (e.orig > 0) out << "  " << u << " " << e.to << " " << e.orig << "\n";
+            for (int a = net.begin(u); a < net.end(u); ++a) {
+                if (net.orig(a) > 0) out << "  " << u << " " << net.to(a) << " " << net.orig(a) << "\n";
             }
         }
         out << ";\n\n";
@@ -5,16 +5,17 @@
 #include <queue>
 #include <limits>
 #include <algorithm>
-#include <functional>
+#include <cstdint>
 
 namespace aod {
 
 long long Dinic::run(FlowNetwork& net, int s, int t, FlowStats& st) {
+  net.freeze();
   const int n = net.n();
-  auto& g = net.adj();
 
   std::vector<int> level(n, -1);
-  std::vector<int> it(n, 0);
+  std::vector<int> it(n, 0); // bieżący łuk (numer w CSR)
+  std::vector<char> dead(n, 0); // ślepe zaułki w bieżącej fazie
 
   auto bfs = [&]() -> bool {
     std::fill(level.begin(), level.end(), -1);
@@ -25,47 +26,84 @@ long long Dinic::run(FlowNetwork& net, int s, int t, FlowStats& st) {
     while (!q.empty()) {
       int v = q.front();
       q.pop();
-      for (const auto& e : g[v]) {
-        if (e.cap <= 0) continue;
-        if (level[e.to] != -1) continue;
-        level[e.to] = level[v] + 1;
-        q.push(e.to);
+      for (int a = net.begin(v); a < net.end(v); ++a) {
+        if (net.cap(a) <= 0) continue;
+        const int to = net.to(a);
+        if (level[to] != -1) continue;
+        level[to] = level[v] + 1;
+        q.push(to);
       }
     }
     st.bfs_runs++;
     return level[t] != -1;
   };
 
-  // DFS: pcha przepływ po grafie poziomów
-  std::function<long long(int,long long)> dfs = [&](int v, long long pushed) -> long long {
+  // przepływ blokujący iteracyjnie: path to stos łuków od s do bieżącego v.
+  // Po dojściu do t cała ścieżka dostaje wąskie gardło, a przeszukiwanie cofa się
+  // tylko do pierwszego nasyconego łuku i szuka dalej, więc jedno przejście
+  // znajduje wiele ścieżek. Wierzchołek bez dopuszczalnych łuków jest oznaczany
+  // jako ślepy zaułek, żeby żadna późniejsza ścieżka w tej fazie już do niego nie weszła.
+  // dfs_calls liczy wywołania dawnego rekurencyjnego DFS-a (nowa ścieżka od s po
+  // każdym powiększeniu, wejścia w ślepe zaułki), żeby wyniki w results/ były porównywalne.
+  std::vector<int> path;
+  path.reserve(n);
+  auto blockingFlow = [&]() -> long long {
+    long long pushed = 0;
+    path.clear();
+    int v = s;
     st.dfs_calls++;
-    if (pushed == 0) return 0;
-    if (v == t) return pushed;
+    while (true) {
+      if (v == t) {
+        long long add = std::numeric_limits<long long>::max();
+        std::size_t cut = 0;
+        for (std::size_t i = 0; i < path.size(); ++i) {
+          if (net.cap(path[i]) < add) {
+            add = net.cap(path[i]);
+            cut = i;
+          }
+        }
+        for (int a : path) {
+          net.cap(a) -= add;
+          net.cap(net.rev(a)) += add;
+        }
+        st.augmentations += (std::int64_t)path.size(); // jak wcześniej: jedno "udane pchnięcie" na łuk
+        pushed += add;
+        st.dfs_calls += 1 + (std::int64_t)cut; // dawny DFS wracał do s i schodził do cut
 
-    for (int& i = it[v]; i < (int)g[v].size(); ++i) {
-      Edge& e = g[v][i];
-      if (e.cap <= 0) continue;
-      if (level[e.to] != level[v] + 1) continue;
+        path.resize(cut);
+        v = path.empty() ? s : net.to(path.back());
+        continue;
+      }
 
-      long long tr = dfs(e.to, std::min(pushed, e.cap));
-      if (tr == 0) continue;
+      int& a = it[v];
+      const int end = net.end(v);
+      for (; a < end; ++a) {
+        if (net.cap(a) <= 0 || level[net.to(a)] != level[v] + 1) continue;
+        if (!dead[net.to(a)]) break;
+        st.dfs_calls++; // dawny DFS wchodził do ślepego zaułka i od razu wracał
+      }
+      if (a < end) {
+        path.push_back(a);
+        v = net.to(a);
+        st.dfs_calls++;
+        continue;
+      }
 
-      e.cap -= tr;
-      g[e.to][e.rev].cap += tr;
-      st.augmentations++; // policzmy "udane pchnięcie"
-      return tr;
+      // ślepy zaułek
+      dead[v] = 1;
+      if (path.empty()) break;
+      path.pop_back();
+      v = path.empty() ? s : net.to(path.back());
+      ++it[v];
     }
-    return 0;
+    return pushed;
   };
 
   long long flow = 0;
   while (bfs()) {
-    std::fill(it.begin(), it.end(), 0);
-    while (true) {
-      long long pushed = dfs(s, std::numeric_limits<long long>::max());
-      if (pushed == 0) break;
-      flow += pushed;
-    }
+    for (int v = 0; v < n; ++v) it[v] = net.begin(v);
+    std::fill(dead.begin(), dead.end(), 0);
+    flow += blockingFlow();
   }
 
   return flow;
@@ -8,8 +8,8 @@
 namespace aod {
 
     long long EdmondsKarp::run(FlowNetwork& net, int s, int t, FlowStats& st) {
+        net.freeze();
         const int n = net.n();
-        auto& g = net.adj();
 
         long long flow = 0;
 
@@ -28,14 +28,14 @@ namespace aod {
                 int v = q.front();
                 q.pop();
 
-                for (int ei = 0; ei < (int)g[v].size(); ++ei) {
-                    const Edge& e = g[v][ei];
-                    if (parent_v[e.to] != -1) continue;   // już odwiedzony
-                    if (e.cap <= 0) continue;             // brak przepustowości w residualu
-                    parent_v[e.to] = v;
-                    parent_e[e.to] = ei;
-                    if (e.to == t) return true;
-                    q.push(e.to);
+                for (int a = net.begin(v); a < net.end(v); ++a) {
+                    const int to = net.to(a);
+                    if (parent_v[to] != -1) continue;     // już odwiedzony
+                    if (net.cap(a) <= 0) continue;        // brak przepustowości w residualu
+                    parent_v[to] = v;
+                    parent_e[to] = a;
+                    if (to == t) return true;
+                    q.push(to);
                 }
             }
             return parent_v[t] != -1;
@@ -47,19 +47,14 @@ namespace aod {
             // bottleneck
             long long add = std::numeric_limits<long long>::max();
             for (int v = t; v != s; v = parent_v[v]) {
-                int pv = parent_v[v];
-                int ei = parent_e[v];
-                add = std::min(add, g[pv][ei].cap);
+                add = std::min(add, net.cap(parent_e[v]));
             }
 
             // augment
             for (int v = t; v != s; v = parent_v[v]) {
-                int pv = parent_v[v];
-                int ei = parent_e[v];
-                Edge& e = g[pv][ei];
-                Edge& rev = g[e.to][e.rev];
-                e.cap -= add;
-                rev.cap += add;
+                int a = parent_e[v];
+                net.cap(a) -= add;
+                net.cap(net.rev(a)) += add;
             }
 
             flow += add;
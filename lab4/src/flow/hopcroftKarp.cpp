@@ -0,0 +1,111 @@
+#include "aod/flow/hopcroftKarp.hpp"
+
+#include <vector>
+#include <limits>
+
+namespace aod {
+
+    long long HopcroftKarp::run(const BipartiteGraph& g, FlowStats& st) {
+        const int L = g.left;
+        constexpr int INF = std::numeric_limits<int>::max();
+
+        mateL_.assign(L, -1);
+        mateR_.assign(g.right, -1);
+        long long matching = 0;
+
+        // wstępne skojarzenie zachłanne: pierwszy wolny sąsiad
+        for (int u = 0; u < L; ++u) {
+            for (int i = g.offset[u]; i < g.offset[u + 1]; ++i) {
+                int v = g.adj[i];
+                if (mateR_[v] == -1) {
+                    mateL_[u] = v;
+                    mateR_[v] = u;
+                    ++matching;
+                    break;
+                }
+            }
+        }
+
+        std::vector<int> dist(L, INF);
+        std::vector<int> queue;
+        queue.reserve(L);
+        std::vector<int> it(L, 0); // bieżący sąsiad w adj
+        std::vector<int> stack;    // wierzchołki V1 bieżącej ścieżki naprzemiennej
+
+        while (true) {
+            // BFS: warstwy od wolnych V1; limit = długość najkrótszej ścieżki do wolnego V2
+            queue.clear();
+            for (int u = 0; u < L; ++u) {
+                if (mateL_[u] == -1) {
+                    dist[u] = 0;
+                    queue.push_back(u);
+                } else {
+                    dist[u] = INF;
+                }
+            }
+            int limit = INF;
+            for (std::size_t h = 0; h < queue.size(); ++h) {
+                int u = queue[h];
+                if (dist[u] >= limit) break;
+                for (int i = g.offset[u]; i < g.offset[u + 1]; ++i) {
+                    int w = mateR_[g.adj[i]];
+                    if (w == -1) {
+                        if (limit == INF) limit = dist[u] + 1;
+                    } else if (dist[w] == INF) {
+                        dist[w] = dist[u] + 1;
+                        queue.push_back(w);
+                    }
+                }
+            }
+            st.bfs_runs++;
+            if (limit == INF) break;
+
+            // DFS po warstwach z jawnym stosem; martwe wierzchołki dostają dist = INF
+            for (int u = 0; u < L; ++u) it[u] = g.offset[u];
+            for (int root = 0; root < L; ++root) {
+                if (mateL_[root] != -1) continue;
+                stack.clear();
+                stack.push_back(root);
+                st.dfs_calls++;
+                while (!stack.empty()) {
+                    int u = stack.back();
+                    bool moved = false;
+                    for (int& i = it[u]; i < g.offset[u + 1]; ++i) {
+                        int v = g.adj[i];
+                        int w = mateR_[v];
+                        if (w == -1) {
+                            if (dist[u] + 1 != limit) continue;
+                            // ścieżka powiększająca: przepinamy pary wzdłuż stosu
+                            for (int x : stack) {
+                                int y = g.adj[it[x]];
+                                mateL_[x] = y;
+                                mateR_[y] = x;
+                            }
+                            for (int x : stack) dist[x] = INF; // każdy V1 w jednej ścieżce na fazę
+                            st.augmentations++;
+                            ++matching;
+                            stack.clear();
+                            moved = true;
+                            break;
+                        }
+                        if (dist[w] == dist[u] + 1 && dist[w] < limit) {
+                            stack.push_back(w);
+                            st.dfs_calls++;
+                            moved = true;
+                            break;
+                        }
+                    }
+                    if (moved) continue;
+
+                    // ślepy zaułek: cofamy się i przesuwamy wskaźnik rodzica
+                    dist[u] = INF;
+                    stack.pop_back();
+                    if (!stack.empty()) ++it[stack.back()];
+                }
+            }
+        }
+
+        return matching;
+    }
+
+}
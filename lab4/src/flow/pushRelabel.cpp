@@ -0,0 +1,197 @@
+#include "aod/flow/pushRelabel.hpp"
+#include "aod/graph/flowNetwork.hpp"
+
+#include <vector>
+#include <algorithm>
+
+namespace aod {
+
+    namespace {
+        // koszt pracy jak w HIPR (Cherkassky, Goldberg): relabel kosztuje BETA + stopień,
+        // a globalne przeetykietowanie następuje po GLOBAL_FREQ * praca > ALPHA * n + m
+        constexpr long long ALPHA = 6;
+        constexpr long long BETA = 12;
+        constexpr double GLOBAL_FREQ = 0.5;
+    }
+
+    long long PushRelabel::run(FlowNetwork& net, int s, int t, FlowStats& st) {
+        net.freeze();
+        const int n = net.n();
+        if (n == 0 || s == t) return 0;
+
+        const long long arcs = net.arc_count();
+
+        const int unreachable = 2 * n; // etykieta wierzchołka bez ścieżki do t ani do s
+        std::vector<int> label(n, 0);
+        std::vector<long long> excess(n, 0);
+        std::vector<int> cur(n, 0); // bieżący łuk v (numer w CSR)
+
+        // kubełki aktywnych wierzchołków; wpis jest nieaktualny, gdy etykieta
+        // wierzchołka się zmieniła albo nadmiar spadł do 0
+        std::vector<std::vector<int>> active(unreachable + 1);
+        int hi = -1; // górne ograniczenie najwyższego niepustego kubełka
+
+        // wierzchołki (bez s i t) o etykiecie < n w listach dwukierunkowych, dla luki
+        std::vector<int> head(n, -1), next(n, -1), prev(n, -1);
+        int top = 0; // górne ograniczenie najwyższej niepustej listy
+
+        auto activate = [&](int v) {
+            if (v == s || v == t) return;
+            active[label[v]].push_back(v);
+            hi = std::max(hi, label[v]);
+        };
+        auto link = [&](int v) {
+            int h = label[v];
+            next[v] = head[h];
+            prev[v] = -1;
+            if (head[h] != -1) prev[head[h]] = v;
+            head[h] = v;
+            top = std::max(top, h);
+        };
+        auto unlink = [&](int v) {
+            int h = label[v];
+            if (prev[v] == -1) head[h] = next[v];
+            else next[prev[v]] = next[v];
+            if (next[v] != -1) prev[next[v]] = prev[v];
+        };
+
+        // dokładne etykiety: odległość do t w sieci residualnej, a dla wierzchołków,
+        // które nie dochodzą do t, n + odległość do s (nadmiar wraca wtedy do źródła)
+        std::vector<int> queue;
+        queue.reserve(n);
+        auto bfs = [&](int root) {
+            queue.clear();
+            queue.push_back(root);
+            for (std::size_t i = 0; i < queue.size(); ++i) {
+                int w = queue[i];
+                for (int a = net.begin(w); a < net.end(w); ++a) {
+                    int u = net.to(a);
+                    if (label[u] != unreachable || net.cap(net.rev(a)) <= 0) continue;
+                    label[u] = label[w] + 1;
+                    queue.push_back(u);
+                }
+            }
+        };
+        auto globalRelabel = [&]() {
+            st.global_updates++;
+            std::fill(label.begin(), label.end(), unreachable);
+            std::fill(head.begin(), head.end(), -1);
+            for (auto& bucket : active) bucket.clear();
+            hi = -1;
+            top = 0;
+
+            label[t] = 0;
+            label[s] = n;
+            bfs(t);
+            bfs(s);
+
+            for (int v = 0; v < n; ++v) {
+                if (v == s || v == t) continue;
+                cur[v] = net.begin(v);
+                if (label[v] < n) link(v);
+                if (excess[v] > 0 && label[v] < unreachable) activate(v);
+            }
+        };
+
+        // luka na poziomie h: wierzchołki powyżej h (i poniżej n) nie dojdą już do t
+        auto gap = [&](int h) {
+            for (int H = h + 1; H <= top; ++H) {
+                for (int w = head[H]; w != -1; w = next[w]) {
+                    label[w] = n;
+                    cur[w] = net.begin(w);
+                    if (excess[w] > 0) activate(w);
+                }
+                head[H] = -1;
+            }
+            top = h - 1;
+        };
+
+        long long work = 0;
+        auto relabel = [&](int v) {
+            st.relabels++;
+            const int h = label[v];
+            int newLabel = unreachable;
+            int arc = net.begin(v);
+            for (int a = net.begin(v); a < net.end(v); ++a) {
+                if (net.cap(a) > 0 && label[net.to(a)] + 1 < newLabel) {
+                    newLabel = label[net.to(a)] + 1;
+                    arc = a;
+                }
+            }
+            work += BETA + (net.end(v) - net.begin(v));
+            cur[v] = arc;
+
+            if (h < n) {
+                unlink(v);
+                if (head[h] == -1) {
+                    // wszystkie sąsiedzi residualni v mają etykiety > h, więc też są za luką
+                    gap(h);
+                    label[v] = std::max(newLabel, n);
+                    return;
+                }
+            }
+            label[v] = newLabel;
+            if (newLabel < n) link(v);
+        };
+
+        auto discharge = [&](int v) {
+            const int end = net.end(v);
+            while (excess[v] > 0) {
+                if (cur[v] == end) {
+                    relabel(v);
+                    if (label[v] >= unreachable) break;
+                    continue;
+                }
+                const int a = cur[v];
+                const int to = net.to(a);
+                if (net.cap(a) > 0 && label[v] == label[to] + 1) {
+                    long long d = std::min(excess[v], net.cap(a));
+                    net.cap(a) -= d;
+                    net.cap(net.rev(a)) += d;
+                    excess[v] -= d;
+                    if (excess[to] == 0) {
+                        excess[to] = d;
+                        activate(to);
+                    } else {
+                        excess[to] += d;
+                    }
+                    st.pushes++;
+                } else {
+                    ++cur[v];
+                }
+            }
+        };
+
+        // wstępny przepływ: nasycamy wszystkie krawędzie wychodzące z s
+        for (int a = net.begin(s); a < net.end(s); ++a) {
+            if (net.cap(a) <= 0) continue;
+            long long d = net.cap(a);
+            net.cap(a) = 0;
+            net.cap(net.rev(a)) += d;
+            excess[net.to(a)] += d;
+            st.pushes++;
+        }
+        globalRelabel();
+
+        const double threshold = (double)(ALPHA * n + arcs);
+        while (hi >= 0) {
+            if (active[hi].empty()) {
+                --hi;
+                continue;
+            }
+            int v = active[hi].back();
+            active[hi].pop_back();
+            if (label[v] != hi || excess[v] == 0) continue;
+
+            discharge(v);
+
+            if (GLOBAL_FREQ * (double)work > threshold) {
+                globalRelabel();
+                work = 0;
+            }
+        }
+
+        return excess[t];
+    }
+
+} // namespace aod
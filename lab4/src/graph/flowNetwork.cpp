@@ -1,25 +1,52 @@
 #include "aod/graph/flowNetwork.hpp"
+#include <stdexcept>
 
 namespace aod {
 
-    void FlowNetwork::add_edge(int u, int v, long long cap) {
-        //forward edge
-        Edge a;
-        a.to = v;
-        a.rev = (int)adj_[v].size();
-        a.cap = cap;
-        a.orig = cap;
-
-        //reverse edge
-        Edge b;
-        b.to = u;
-        b.rev = (int)adj_[u].size();
-        b.cap = 0;
-        b.orig = 0;
-
-        adj_[u].push_back(a);
-        adj_[v].push_back(b);
+    void FlowNetwork::reset(int n) {
+        *this = FlowNetwork(n);
     }
 
-}
+    int FlowNetwork::add_edge(int u, int v, long long cap) {
+        if (frozen()) throw std::runtime_error("add_edge after freeze()");
+        int idx = deg_[u]++; // forward w u
+        deg_[v]++;           // reverse w v
+        pending_.push_back({u, v, cap});
+        return idx;
+    }
+
+    void FlowNetwork::freeze() {
+        if (frozen()) return;
+
+        offset_.assign((std::size_t)n_ + 1, 0);
+        for (int u = 0; u < n_; ++u) offset_[u + 1] = offset_[u] + deg_[u];
+
+        const std::size_t arcs = (std::size_t)offset_[n_];
+        to_.resize(arcs);
+        rev_.resize(arcs);
+        cap_.resize(arcs);
+        orig_.resize(arcs);
 
+        // wstawianie w kolejności add_edge zachowuje numerację łuków w listach
+        std::vector<int> pos(offset_.begin(), offset_.end() - 1);
+        for (const auto& e : pending_) {
+            int a = pos[e.u]++; // forward
+            int b = pos[e.v]++; // reverse
+            to_[a] = e.v;
+            rev_[a] = b;
+            cap_[a] = e.cap;
+            orig_[a] = e.cap;
+
+            to_[b] = e.u;
+            rev_[b] = a;
+            cap_[b] = 0;
+            orig_[b] = 0;
+        }
+
+        pending_.clear();
+        pending_.shrink_to_fit();
+        deg_.clear();
+        deg_.shrink_to_fit();
+    }
+
+}
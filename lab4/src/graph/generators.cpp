@@ -25,8 +25,7 @@ namespace aod {
         inst.forward_edges.clear();
         inst.forward_edges.reserve((std::size_t)k * (std::size_t)(1u << (k - 1)));
 
-        // (opcjonalnie) przyspieszenie: typowo ~k wyjść + reverse edges, więc rezerwujemy trochę
-        for (int v = 0; v < n; ++v) inst.net.adj()[v].reserve((std::size_t)2 * (std::size_t)k);
+        inst.net.reserve_edges((std::size_t)k * (std::size_t)(1u << (k - 1)));
 
         RNG rng(seed);
 
@@ -47,32 +46,59 @@ namespace aod {
                 const long long cap_max = 1LL << l;        // 2^l
                 const long long cap = rng.uniform_ll(1, cap_max);
 
-                inst.net.add_edge(i, j, cap);
-
                 // zapisz referencję do właśnie dodanej krawędzi forward
-                int idx = (int)inst.net.adj()[i].size() - 1;
+                int idx = inst.net.add_edge(i, j, cap);
                 inst.forward_edges.push_back({i, idx});
             }
         }
 
+        inst.net.freeze();
         return inst;
     }
 
-    GeneratedFlowInstance generate_bipartite_matching(int k, int degree, std::uint64_t seed) {
-        if (k < 1 || k > 16) throw std::runtime_error("k out of range (expected 1..16 for labs)");
+    BipartiteGraph generate_bipartite(int k, int degree, std::uint64_t seed) {
+        if (k < 1 || k > 20) throw std::runtime_error("k out of range (expected 1..20 for matching)");
         const int m = 1 << k;                 // |V1|=|V2|=2^k
         if (degree < 0) throw std::runtime_error("degree must be >= 0");
         if (degree > m) throw std::runtime_error("degree > |V2| would force duplicates / infinite loop");
 
+        BipartiteGraph g;
+        g.left = m;
+        g.right = m;
+        g.offset.assign((std::size_t)m + 1, 0);
+        g.adj.reserve((std::size_t)m * (std::size_t)degree);
+
+        RNG rng(seed);
+
+        // dokładnie 'degree' unikalnych sąsiadów na każdy u
+        for (int u = 0; u < m; ++u) {
+            std::unordered_set<int> chosen;
+            chosen.reserve((std::size_t)degree * 2);
+
+            while ((int)chosen.size() < degree) {
+                int v = rng.uniform_int(0, m - 1);
+                chosen.insert(v);
+            }
+
+            for (int v : chosen) g.adj.push_back(v);
+            g.offset[u + 1] = (int)g.adj.size();
+        }
+
+        return g;
+    }
+
+    GeneratedFlowInstance bipartite_flow_network(const BipartiteGraph& g) {
+        const int m = g.left;
+
         // Układ wierzchołków w sieci:
         // S=0
         // V1: [1 .. m]
-        // V2: [1+m .. 2m]
-        // T = 1+2m
+        // V2: [1+m .. 1+m+right-1]
+        // T = 1+m+right
         const int S = 0;
         const int V1_start = 1;
         const int V2_start = 1 + m;
-        const int T = 1 + 2 * m;
+        const int T = 1 + m + g.right;
         const int N = T + 1;
 
         GeneratedFlowInstance inst;
@@ -80,17 +106,9 @@ namespace aod {
         inst.s = S;
         inst.t = T;
         inst.forward_edges.clear();
-        inst.forward_edges.reserve((std::size_t)m * (std::size_t)degree);
+        inst.forward_edges.reserve(g.adj.size());
 
-        // Rezerwy (opcjonalnie, ale pomaga)
-        inst.net.adj()[S].reserve((std::size_t)m);
-        inst.net.adj()[T].reserve((std::size_t)m);
-        for (int u = 0; u < m; ++u) {
-            inst.net.adj()[V1_start + u].reserve((std::size_t)(degree + 1) * 2);
-            inst.net.adj()[V2_start + u].reserve((std::size_t)2 * 2);
-        }
-
-        RNG rng(seed);
+        inst.net.reserve_edges(g.adj.size() + (std::size_t)m + (std::size_t)g.right);
 
         // S -> V1 (cap 1)
         for (int u = 0; u < m; ++u) {
@@ -98,32 +116,27 @@ namespace aod {
         }
 
         // V2 -> T (cap 1)
-        for (int v = 0; v < m; ++v) {
+        for (int v = 0; v < g.right; ++v) {
             inst.net.add_edge(V2_start + v, T, 1);
         }
 
-        // V1 -> V2 (cap 1), dokładnie 'degree' unikalnych sąsiadów na każdy u
+        // V1 -> V2 (cap 1)
         for (int u = 0; u < m; ++u) {
-            std::unordered_set<int> chosen;
-            chosen.reserve((std::size_t)degree * 2);
-
-            while ((int)chosen.size() < degree) {
-                int v = rng.uniform_int(0, m - 1);
-                chosen.insert(v);
-            }
-
             int nu = V1_start + u;
-            for (int v : chosen) {
-                int nv = V2_start + v;
-                inst.net.add_edge(nu, nv, 1);
-
+            for (int i = g.offset[u]; i < g.offset[u + 1]; ++i) {
+                int nv = V2_start + g.adj[i];
                 // referencja do właśnie dodanej forward-krawędzi nu -> nv
-                int idx = (int)inst.net.adj()[nu].size() - 1;
+                int idx = inst.net.add_edge(nu, nv, 1);
                 inst.forward_edges.push_back({nu, idx});
             }
         }
 
+        inst.net.freeze();
         return inst;
     }
 
+    GeneratedFlowInstance generate_bipartite_matching(int k, int degree, std::uint64_t seed) {
+        return bipartite_flow_network(generate_bipartite(k, degree, seed));
+    }
+
 } // namespace aod
@@ -2,6 +2,7 @@
 #include "aod/graph/generators.hpp"
 #include "aod/flow/edmondsKarp.hpp"
 #include "aod/flow/dinic.hpp"
+#include "aod/flow/pushRelabel.hpp"
 #include "aod/export/glpk_mathprog.hpp"
 #include <iostream>
 #include <string>
@@ -56,6 +57,9 @@ int main(int argc, char** argv) {
     if (algo == "dinic") {
         aod::Dinic mf;
         maxflow = mf.run(inst.net, inst.s, inst.t, st);
+    } else if (algo == "pr") {
+        aod::PushRelabel mf;
+        maxflow = mf.run(inst.net, inst.s, inst.t, st);
     } else {
         aod::EdmondsKarp mf;
         maxflow = mf.run(inst.net, inst.s, inst.t, st);
@@ -64,11 +68,11 @@ int main(int argc, char** argv) {
         for (const auto& ref : inst.forward_edges) {
             int u = ref.first;
             int idx = ref.second;
-            const auto& e = inst.net.adj()[u][idx];
+            const int a = inst.net.arc(u, idx);
 
-            long long f = e.orig - e.cap;   // przepływ na krawędzi forward
+            long long f = inst.net.flow(a);   // przepływ na krawędzi forward
 
-            std::cout << u << " " << e.to << " " << f << "\n";
+            std::cout << u << " " << inst.net.to(a) << " " << f << "\n";
         }
     }
 
@@ -2,6 +2,8 @@
 #include "aod/graph/generators.hpp"
 #include "aod/flow/edmondsKarp.hpp"
 #include "aod/flow/dinic.hpp"
+#include "aod/flow/pushRelabel.hpp"
+#include "aod/flow/hopcroftKarp.hpp"
 #include "aod/export/glpk_mathprog.hpp"
 #include <iostream>
 #include <string>
@@ -43,11 +45,33 @@ int main(int argc, char** argv) {
 
     aod::Timer timer;
 
-    auto inst = aod::generate_bipartite_matching(k, deg, seed);
+    auto graph = aod::generate_bipartite(k, deg, seed);
 
     aod::FlowStats st;
     long long maxflow = 0;
 
+    // Hopcroft–Karp liczy na samym grafie dwudzielnym, bez sieci S/T
+    if (algo == "hk" && !useGlpk) {
+        aod::HopcroftKarp hk;
+        maxflow = hk.run(graph, st);
+
+        if (printMatching) {
+            // ta sama kolejność co dla max-flow: u rosnąco, sąsiedzi w kolejności generatora
+            const auto& mate = hk.mate_left();
+            for (int u = 0; u < graph.left; ++u) {
+                for (int i = graph.offset[u]; i < graph.offset[u + 1]; ++i) {
+                    if (mate[u] == graph.adj[i]) std::cout << u << " " << graph.adj[i] << "\n";
+                }
+            }
+        }
+
+        std::cout << maxflow << "\n";
+        std::cerr << timer.ms() << "\n";
+        return 0;
+    }
+
+    auto inst = aod::bipartite_flow_network(graph);
+
     if (useGlpk) {
         aod::export_maxflow_mathprog(inst.net, inst.s, inst.t, glpkPath);
         return 0;
@@ -56,6 +80,9 @@ int main(int argc, char** argv) {
     if (algo == "dinic") {
         aod::Dinic mf;
         maxflow = mf.run(inst.net, inst.s, inst.t, st);
+    } else if (algo == "pr") {
+        aod::PushRelabel mf;
+        maxflow = mf.run(inst.net, inst.s, inst.t, st);
     } else {
         aod::EdmondsKarp mf;
         maxflow = mf.run(inst.net, inst.s, inst.t, st);
@@ -69,12 +96,12 @@ int main(int argc, char** argv) {
         for (const auto& ref : inst.forward_edges) {
             int nu = ref.first;
             int idx = ref.second;
-            const auto& e = inst.net.adj()[nu][idx];
+            const int a = inst.net.arc(nu, idx);
 
-            long long f = e.orig - e.cap; // 0 albo 1
+            long long f = inst.net.flow(a); // 0 albo 1
             if (f == 1) {
                 int u = nu - V1_start;      // etykieta w V1: 0..m-1
-                int v = e.to - V2_start;    // etykieta w V2: 0..m-1
+                int v = inst.net.to(a) - V2_start;    // etykieta w V2: 0..m-1
                 std::cout << u << " " << v << "\n";
             }
         }
@@ -1,12 +1,25 @@
 #include "aod/graph/generators.hpp"
 #include "aod/flow/edmondsKarp.hpp"
 #include "aod/flow/dinic.hpp"
+#include "aod/flow/pushRelabel.hpp"
+#include "aod/flow/hopcroftKarp.hpp"
 #include "aod/flow/maxflowBase.hpp"
+#include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
 #include <iostream>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <vector>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 static int require_int(int& i, int argc, char** argv) {
     if (i + 1 >= argc) { std::cerr << "Missing value after " << argv[i] << "\n"; std::exit(2); }
@@ -26,6 +39,220 @@ static long long now_us() {
     return std::chrono::duration_cast<std::chrono::microseconds>(clk::now().time_since_epoch()).count();
 }
 
+// Jedno zadanie sweepu: instancja (k, i, rep). Klasa pomiarowa to k: zadania
+// tej samej wielkości walczą o te same cache i przepustowość pamięci, więc
+// --class-limit ogranicza, ile z nich liczy się jednocześnie.
+struct Job {
+    int k = 0;
+    int deg = 0; // tylko task2
+    int rep = 0;
+    std::uint64_t seed = 0;
+};
+
+// Wszystkie algorytmy liczą na jednej sieci inst.net (bez kopii);
+// reset_flow() przywraca pojemności przed kolejnym algorytmem.
+static std::string run_task1(const Job& job) {
+    aod::EdmondsKarp ek;
+    aod::Dinic dinic;
+    aod::PushRelabel pr;
+
+    auto inst = aod::generate_hypercube(job.k, job.seed);
+
+    // EK
+    aod::FlowStats st_ek;
+    long long t1 = now_us();
+    long long f1 = ek.run(inst.net, inst.s, inst.t, st_ek);
+    long long t2 = now_us();
+
+    // Dinic
+    aod::FlowStats st_d;
+    inst.net.reset_flow();
+    long long t3 = now_us();
+    long long f2 = dinic.run(inst.net, inst.s, inst.t, st_d);
+    long long t4 = now_us();
+
+    // Push-relabel
+    aod::FlowStats st_pr;
+    inst.net.reset_flow();
+    long long t5 = now_us();
+    long long f3 = pr.run(inst.net, inst.s, inst.t, st_pr);
+    long long t6 = now_us();
+
+    if (f1 != f2 || f1 != f3) {
+        throw std::runtime_error("Mismatch! k=" + std::to_string(job.k) + " rep=" + std::to_string(job.rep)
+            + " ek=" + std::to_string(f1) + " dinic=" + std::to_string(f2) + " pr=" + std::to_string(f3));
+    }
+
+    std::ostringstream line;
+    line
+        << "1" << "," << job.k << "," << job.rep << "," << job.seed << ","
+        << f1 << ","
+        << (t2 - t1) << "," << st_ek.augmentations << ","
+        << (t4 - t3) << "," << st_d.bfs_runs << "," << st_d.dfs_calls << "," << st_d.augmentations << ","
+        << (t6 - t5) << "," << st_pr.pushes << "," << st_pr.relabels << "," << st_pr.global_updates
+        << "\n";
+    return line.str();
+}
+
+static std::string run_task2(const Job& job) {
+    aod::EdmondsKarp ek;
+    aod::Dinic dinic;
+    aod::PushRelabel pr;
+    aod::HopcroftKarp hk;
+
+    // jedna instancja: sieć S/T dla EK/Dinica/PR i ten sam graf dla HK
+    auto graph = aod::generate_bipartite(job.k, job.deg, job.seed);
+    auto inst = aod::bipartite_flow_network(graph);
+
+    // EK
+    aod::FlowStats st_ek;
+    long long t1 = now_us();
+    long long m1 = ek.run(inst.net, inst.s, inst.t, st_ek);
+    long long t2 = now_us();
+
+    // Dinic
+    aod::FlowStats st_d;
+    inst.net.reset_flow();
+    long long t3 = now_us();
+    long long m2 = dinic.run(inst.net, inst.s, inst.t, st_d);
+    long long t4 = now_us();
+
+    // Push-relabel
+    aod::FlowStats st_pr;
+    inst.net.reset_flow();
+    long long t5 = now_us();
+    long long m3 = pr.run(inst.net, inst.s, inst.t, st_pr);
+    long long t6 = now_us();
+
+    // Hopcroft–Karp
+    aod::FlowStats st_hk;
+    long long t7 = now_us();
+    long long m4 = hk.run(graph, st_hk);
+    long long t8 = now_us();
+
+    if (m1 != m2 || m1 != m3 || m1 != m4) {
+        throw std::runtime_error("Mismatch! k=" + std::to_string(job.k) + " i=" + std::to_string(job.deg)
+            + " rep=" + std::to_string(job.rep) + " ek=" + std::to_string(m1) + " dinic=" + std::to_string(m2)
+            + " pr=" + std::to_string(m3) + " hk=" + std::to_string(m4));
+    }
+
+    std::ostringstream line;
+    line
+        << "2" << "," << job.k << "," << job.deg << "," << job.rep << "," << job.seed << ","
+        << m1 << ","
+        << (t2 - t1) << ","
+        << (t4 - t3) << "," << st_d.bfs_runs << "," << st_d.dfs_calls << ","
+        << (t6 - t5) << "," << st_pr.pushes << "," << st_pr.relabels << "," << st_pr.global_updates << ","
+        << (t8 - t7) << "," << st_hk.bfs_runs << "," << st_hk.augmentations
+        << "\n";
+    return line.str();
+}
+
+// CPU dozwolone dla procesu (z uwzględnieniem taskset); pusty wynik = bez przypinania
+static std::vector<int> allowed_cpus() {
+    std::vector<int> cpus;
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (int c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &set)) cpus.push_back(c);
+        }
+    }
+#endif
+    return cpus;
+}
+
+static void pin_thread(std::thread& th, int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    pthread_setaffinity_np(th.native_handle(), sizeof(set), &set);
+#else
+    (void)th;
+    (void)cpu;
+#endif
+}
+
+// Pula wątków: każdy wątek jest przypięty do innego CPU i bierze pierwsze
+// w kolejności zadanie, którego klasa (k) nie ma już class_limit uruchomionych
+// zadań. Wiersze CSV są wypisywane w kolejności zadań, gdy tylko gotowy jest
+// cały prefiks, więc wynik nie zależy od liczby wątków (poza czasami).
+// Zwraca false po pierwszym błędzie (nowe zadania nie są już startowane).
+static bool run_parallel(const std::vector<Job>& jobs, int workers, int class_limit, int kmax,
+                         std::string (*run)(const Job&)) {
+    enum State { Pending, Running, Done };
+    std::vector<State> state(jobs.size(), Pending);
+    std::vector<std::string> lines(jobs.size());
+    std::vector<std::string> errors(jobs.size());
+    std::vector<int> running_in_class((std::size_t)kmax + 1, 0);
+    std::size_t first_pending = 0;
+    std::size_t next_print = 0;
+    bool failed = false;
+
+    std::mutex mu;
+    std::condition_variable cv;
+
+    auto worker = [&]() {
+        std::unique_lock<std::mutex> lock(mu);
+        while (true) {
+            while (first_pending < jobs.size() && state[first_pending] != Pending) ++first_pending;
+            if (failed || first_pending == jobs.size()) return;
+
+            std::size_t pick = jobs.size();
+            for (std::size_t j = first_pending; j < jobs.size(); ++j) {
+                if (state[j] == Pending && (class_limit <= 0 || running_in_class[jobs[j].k] < class_limit)) {
+                    pick = j;
+                    break;
+                }
+            }
+            if (pick == jobs.size()) {
+                cv.wait(lock);
+                continue;
+            }
+
+            state[pick] = Running;
+            running_in_class[jobs[pick].k]++;
+            lock.unlock();
+
+            std::string line, error;
+            try {
+                line = run(jobs[pick]);
+            } catch (const std::exception& e) {
+                error = e.what();
+            }
+
+            lock.lock();
+            lines[pick] = std::move(line);
+            errors[pick] = std::move(error);
+            state[pick] = Done;
+            running_in_class[jobs[pick].k]--;
+            while (!failed && next_print < jobs.size() && state[next_print] == Done) {
+                if (!errors[next_print].empty()) {
+                    std::cerr << errors[next_print] << "\n";
+                    failed = true;
+                    break;
+                }
+                std::cout << lines[next_print];
+                lines[next_print].clear();
+                ++next_print;
+            }
+            std::cout.flush();
+            cv.notify_all();
+        }
+    };
+
+    const std::vector<int> cpus = allowed_cpus();
+    std::vector<std::thread> pool;
+    for (int w = 0; w < workers; ++w) {
+        pool.emplace_back(worker);
+        if ((std::size_t)w < cpus.size()) pin_thread(pool.back(), cpus[(std::size_t)w]);
+    }
+    for (auto& th : pool) th.join();
+    return !failed;
+}
+
 int main(int argc, char** argv) {
     // Domyślnie: benchmark task1 dla k=1..16, reps=1
     int task = 1;
@@ -40,6 +267,13 @@ int main(int argc, char** argv) {
 
     std::uint64_t seed0 = 0; // 0 => auto w generatorze RNG (u Ciebie)
 
+    // Równoległy sweep: --jobs N wątków (0 = wszystkie dostępne CPU),
+    // --class-limit L zadań o tym samym k naraz (domyślnie 1 przy kilku wątkach,
+    // 0 = jawnie bez limitu)
+    int jobs_n = 1;
+    int class_limit = 0;
+    bool have_class_limit = false;
+
     for (int i = 1; i < argc; ++i) {
         std::string a = argv[i];
         if (a == "--task") task = require_int(i, argc, argv);
@@ -49,6 +283,8 @@ int main(int argc, char** argv) {
         else if (a == "--imin") { imin = require_int(i, argc, argv); have_i_range = true; }
         else if (a == "--imax") { imax = require_int(i, argc, argv); have_i_range = true; }
         else if (a == "--seed") seed0 = require_u64(i, argc, argv);
+        else if (a == "--jobs") jobs_n = require_int(i, argc, argv);
+        else if (a == "--class-limit") { class_limit = require_int(i, argc, argv); have_class_limit = true; }
         else {
             std::cerr << "Unknown arg: " << a << "\n";
             return 2;
@@ -67,53 +303,42 @@ int main(int argc, char** argv) {
         std::cerr << "reps must be >= 1\n";
         return 2;
     }
+    if (jobs_n < 0 || class_limit < 0) {
+        std::cerr << "--jobs and --class-limit must be >= 0\n";
+        return 2;
+    }
+    // każdy wątek musi dostać własny rdzeń, inaczej czasy algorytmów rosną
+    // przez współdzielenie CPU (pusta lista CPU = bez przypinania i bez limitu)
+    const std::size_t cpu_count = allowed_cpus().size();
+    if (jobs_n == 0) {
+        jobs_n = (int)std::max<std::size_t>(1, cpu_count);
+    } else if (cpu_count > 0 && (std::size_t)jobs_n > cpu_count) {
+        std::cerr << "--jobs " << jobs_n << " exceeds the " << cpu_count << " available CPUs\n";
+        return 2;
+    }
+    // instancje tej samej wielkości obok siebie zawyżają sobie czasy
+    if (!have_class_limit && jobs_n > 1) class_limit = 1;
 
     // CSV header
     if (task == 1) {
         std::cout
-            << "task,k,rep,seed,flow,ek_us,ek_aug,dinic_us,dinic_bfs,dinic_dfs,dinic_aug\n";
+            << "task,k,rep,seed,flow,ek_us,ek_aug,dinic_us,dinic_bfs,dinic_dfs,dinic_aug,"
+            << "pr_us,pr_pushes,pr_relabels,pr_global\n";
     } else {
         std::cout
-            << "task,k,i,rep,seed,matching,ek_us,dinic_us,dinic_bfs,dinic_dfs\n";
+            << "task,k,i,rep,seed,matching,ek_us,dinic_us,dinic_bfs,dinic_dfs,"
+            << "pr_us,pr_pushes,pr_relabels,pr_global,hk_us,hk_phases,hk_aug\n";
     }
 
-    aod::EdmondsKarp ek;
-    aod::Dinic dinic;
-
+    // lista zadań w kolejności wierszy CSV
+    std::vector<Job> jobs;
     for (int k = kmin; k <= kmax; ++k) {
         if (task == 1) {
             for (int rep = 0; rep < reps; ++rep) {
                 // Seed per run: seed0==0 => generator sam zrobi auto_seed, ale wtedy trudniej powtórzyć.
                 // Jeśli seed0 != 0 to rozjeżdżamy seed deterministycznie po rep/k.
                 std::uint64_t seed = seed0 ? (seed0 + (std::uint64_t)k * 1000003ULL + (std::uint64_t)rep) : 0;
-
-                auto inst = aod::generate_hypercube(k, seed);
-
-                // EK
-                aod::FlowStats st_ek;
-                auto net_ek = inst.net; // kopia bazowej sieci
-                long long t1 = now_us();
-                long long f1 = ek.run(net_ek, inst.s, inst.t, st_ek);
-                long long t2 = now_us();
-
-                // Dinic
-                aod::FlowStats st_d;
-                auto net_d = inst.net; // kopia bazowej sieci
-                long long t3 = now_us();
-                long long f2 = dinic.run(net_d, inst.s, inst.t, st_d);
-                long long t4 = now_us();
-
-                if (f1 != f2) {
-                    std::cerr << "Mismatch! k=" << k << " rep=" << rep << " ek=" << f1 << " dinic=" << f2 << "\n";
-                    return 1;
-                }
-
-                std::cout
-                    << "1" << "," << k << "," << rep << "," << seed << ","
-                    << f1 << ","
-                    << (t2 - t1) << "," << st_ek.augmentations << ","
-                    << (t4 - t3) << "," << st_d.bfs_runs << "," << st_d.dfs_calls << "," << st_d.augmentations
-                    << "\n";
+                jobs.push_back({k, 0, rep, seed});
             }
         } else {
             // task2: dla każdego k iterujemy po i (stopień)
@@ -123,40 +348,28 @@ int main(int argc, char** argv) {
             for (int deg = local_imin; deg <= local_imax; ++deg) {
                 for (int rep = 0; rep < reps; ++rep) {
                     std::uint64_t seed = seed0 ? (seed0 + (std::uint64_t)k * 1000003ULL + (std::uint64_t)deg * 10007ULL + (std::uint64_t)rep) : 0;
-
-                    auto inst = aod::generate_bipartite_matching(k, deg, seed);
-
-                    // EK
-                    aod::FlowStats st_ek;
-                    auto net_ek = inst.net;
-                    long long t1 = now_us();
-                    long long m1 = ek.run(net_ek, inst.s, inst.t, st_ek);
-                    long long t2 = now_us();
-
-                    // Dinic
-                    aod::FlowStats st_d;
-                    auto net_d = inst.net;
-                    long long t3 = now_us();
-                    long long m2 = dinic.run(net_d, inst.s, inst.t, st_d);
-                    long long t4 = now_us();
-
-                    if (m1 != m2) {
-                        std::cerr << "Mismatch! k=" << k << " i=" << deg << " rep=" << rep
-                            << " ek=" << m1 << " dinic=" << m2 << "\n";
-                        return 1;
-                    }
-
-                    std::cout
-                        << "2" << "," << k << "," << deg << "," << rep << "," << seed << ","
-                        << m1 << ","
-                        << (t2 - t1) << ","
-                        << (t4 - t3) << "," << st_d.bfs_runs << "," << st_d.dfs_calls
-                        << "\n";
+                    jobs.push_back({k, deg, rep, seed});
                 }
             }
         }
     }
 
+    auto run = task == 1 ? run_task1 : run_task2;
+
+    if (jobs_n == 1) {
+        for (const auto& job : jobs) {
+            try {
+                std::cout << run(job);
+            } catch (const std::exception& e) {
+                std::cerr << e.what() << "\n";
+                return 1;
+            }
+        }
+        return 0;
+    }
+
+    if (!run_parallel(jobs, jobs_n, class_limit, kmax, run)) return 1;
+
     return 0;
 }
 